@@ -2,873 +2,5481 @@
 #include <fstream>
 #include <sstream>
 #include <climits>
+#include <cassert>
 #include <cstring>
 #include <cmath> 
 #include <cstdlib>
+#include <cstdio>
 #include <ctime>
+#include <thread>
+#include <cstdint>
+#include <type_traits>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
-class Traffic
+// Key hashes for HashIndex and the sketches: FNV-1a for strings, then a 64-bit finalizer so every bit of the key
+// reaches the low bits the table masks with
+inline unsigned long long mixHash(unsigned long long hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+inline unsigned long long hashKey(const string &key)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (char ch : key)
+    {
+        hash ^= (unsigned char)ch;
+        hash *= 1099511628211ULL;
+    }
+    return mixHash(hash);
+}
+
+inline unsigned long long hashKey(int key)
+{
+    return mixHash((unsigned long long)(unsigned int)key);
+}
+
+// Small number identifying the calling thread, handed out round-robin on first use
+inline int threadSlot()
+{
+    static int nextSlot = 0;
+    thread_local int slot = __atomic_fetch_add(&nextSlot, 1, __ATOMIC_RELAXED);
+    return slot;
+}
+
+// Counters that several threads can bump at once
+// Each thread adds into its own shard (a cache-line aligned copy of every counter), so concurrent
+// ingestion does not bounce lines between cores; a read sums the shards. Threads beyond SHARDS
+// share shards, which is why adds are still atomic (relaxed: counts need no ordering).
+template <int COUNT>
+class ShardedCounters
 {
 public:
-    static const int MAX_NODES = 26; // Number of nodes (A to Z)
-    static const int TABLE_SIZE = 100;
-    int roads[MAX_NODES][MAX_NODES];
+    static const int SHARDS = 8;
 
-    struct Road
+private:
+    struct alignas(64) Shard
     {
-        string roadName;
-        int vehicleCount;
-        Road *next;
+        int value[COUNT];
     };
 
-    Road *table[TABLE_SIZE];
+    Shard shards[SHARDS];
 
-    // hash function for road name
-    int hashFunction(const string &name)
+public:
+    ShardedCounters()
     {
-        int hash = 0;
-        for (char ch : name)
-        {
-            hash = (hash * 31 + ch) % TABLE_SIZE;
-        }
-        return hash;
+        clear();
     }
 
-   //adding road in the hash table
-    void addRoad(const string &name)
+    void add(int id, int amount)
     {
-        int index = hashFunction(name);
-        Road *newRoad = new Road{name, 1, nullptr};
-        if (table[index] == nullptr)
-        {
-            table[index] = newRoad;
-        }
-        else
-        {
-            Road *current = table[index];
-            while (current->next != nullptr)
-            {
-                current = current->next;
-            }
-            current->next = newRoad;
-        }
+        __atomic_fetch_add(&shards[threadSlot() % SHARDS].value[id], amount, __ATOMIC_RELAXED);
     }
 
-    // Increasing the vehicle count for a road
-    void updateRoadCount(const string &name)
+    // Sum over the shards; exact once the writers have finished
+    int value(int id) const
     {
-        int index = hashFunction(name);
-        Road *current = table[index];
-        while (current != nullptr)
-        {
-            if (current->roadName == name)
-            {
-                current->vehicleCount += 1;
-                return;
-            }
-            current = current->next;
-        }
-        addRoad(name);
+        int total = 0;
+        for (int s = 0; s < SHARDS; s++)
+            total += __atomic_load_n(&shards[s].value[id], __ATOMIC_RELAXED);
+        return total;
+    }
+
+    void clear()
+    {
+        for (int s = 0; s < SHARDS; s++)
+            for (int i = 0; i < COUNT; i++)
+                shards[s].value[i] = 0;
     }
+};
+
+// Count-Min sketch: approximate counts for an unbounded set of keys in fixed memory
+// Each key bumps one counter per row; its estimate is the smallest of them, which never
+// undercounts and overcounts by at most about 2/WIDTH of the total with high probability.
+// Sketches of the same shape merge by adding counters.
+class CountMinSketch
+{
+public:
+    static const int DEPTH = 4;
+    static const int WIDTH = 1 << 16; // Power of two; 1 MB per sketch keeps feeds of a few hundred thousand trips within a few counts
 
+private:
+    int counts[DEPTH][WIDTH];
 
-    Traffic()
+    static int column(unsigned long long hash, int row)
     {
-        for (int i = 0; i < MAX_NODES; i++)
-        {
-            for (int j = 0; j < MAX_NODES; j++)
-            {
-                roads[i][j] = 0;
-            }
-        }
-        for (int i = 0; i < TABLE_SIZE; i++)
-        {
-            table[i] = nullptr;
-        }
+        return (int)(mixHash(hash + 0x9e3779b97f4a7c15ULL * (row + 1)) & (WIDTH - 1));
     }
 
-    int getNodeIndex(char node)
+public:
+    CountMinSketch()
     {
-        return node - 'A';
+        clear();
     }
 
-    
-    void loadData(const string &filename)
+    // Safe from several threads at once
+    void add(unsigned long long hash, int amount)
     {
-        ifstream file(filename);
-        if (!file.is_open())
+        for (int row = 0; row < DEPTH; row++)
+            __atomic_fetch_add(&counts[row][column(hash, row)], amount, __ATOMIC_RELAXED);
+    }
+
+    // Counter of a key in one row
+    int count(unsigned long long hash, int row) const
+    {
+        return __atomic_load_n(&counts[row][column(hash, row)], __ATOMIC_RELAXED);
+    }
+
+    int estimate(unsigned long long hash) const
+    {
+        int best = INT_MAX;
+        for (int row = 0; row < DEPTH; row++)
         {
-            cerr << "Error: Unable to open file!" << endl;
-            return;
+            int value = count(hash, row);
+            if (value < best)
+                best = value;
         }
+        return best;
+    }
 
-        string line;
-        getline(file, line); // Skip header
+    void merge(const CountMinSketch &other)
+    {
+        for (int row = 0; row < DEPTH; row++)
+            for (int i = 0; i < WIDTH; i++)
+                counts[row][i] += other.counts[row][i];
+    }
 
-        while (getline(file, line))
-        {
-            stringstream ss(line);
-            string vehicleID, start, end;
-            getline(ss, vehicleID, ',');
-            getline(ss, start, ',');
-            getline(ss, end, ',');
+    void clear()
+    {
+        for (int row = 0; row < DEPTH; row++)
+            for (int i = 0; i < WIDTH; i++)
+                counts[row][i] = 0;
+    }
+};
 
-            roads[getNodeIndex(start[0])][getNodeIndex(end[0])] = 1;
+// HyperLogLog: approximate number of distinct keys in REGISTERS bytes
+// The top bits of a key's hash pick a register, which keeps the longest run of leading zeros
+// seen in the rest; the harmonic mean of the registers gives the count (about 13% error with 64
+// registers). Sketches merge by taking the larger register, so a merge counts the union.
+class HyperLogLog
+{
+public:
+    static const int INDEX_BITS = 6;
+    static const int REGISTERS = 1 << INDEX_BITS;
 
-           
-            for (char curNode = start[0]; curNode != end[0];)
-            {
-                char nextNode = curNode + 1;
-                if (nextNode > end[0])
-                    break;
-                string road = string(1, curNode) + " to " + string(1, nextNode);
-                updateRoadCount(road);
-                curNode = nextNode;
-            }
-        }
+private:
+    unsigned char registers[REGISTERS];
 
-        file.close();
+public:
+    HyperLogLog()
+    {
+        clear();
     }
 
-  
-    void showCongestion()
+    // Safe from several threads at once
+    void add(unsigned long long hash)
     {
-        bool congestionFound = false;
-        cout << "------ Congestion Status ------" << endl;
-        const int threshold = 3;
+        int index = (int)(hash >> (64 - INDEX_BITS));
+        unsigned long long rest = hash << INDEX_BITS;
+        unsigned char rank = rest == 0 ? 64 - INDEX_BITS + 1 : (unsigned char)(__builtin_clzll(rest) + 1);
 
-        for (int i = 0; i < TABLE_SIZE; i++)
+        unsigned char seen = __atomic_load_n(&registers[index], __ATOMIC_RELAXED);
+        while (rank > seen && !__atomic_compare_exchange_n(&registers[index], &seen, rank, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
         {
-            Road *current = table[i];
-            while (current != nullptr)
-            {
-                if (current->vehicleCount >= threshold)
-                {
-                    cout << current->roadName << " -> Vehicles: " << current->vehicleCount << " (Congested)" << endl;
-                    congestionFound = true;
-                }
-                else if (current->vehicleCount > 0)
-                {
-                    cout << current->roadName << " -> Vehicles: " << current->vehicleCount << endl;
-                }
-                current = current->next;
-            }
         }
+    }
 
-        if (!congestionFound)
+    int estimate() const
+    {
+        double sum = 0;
+        int zeros = 0;
+        for (int i = 0; i < REGISTERS; i++)
         {
-            cout << "No congested roads detected." << endl;
+            sum += ldexp(1.0, -registers[i]);
+            if (registers[i] == 0)
+                zeros++;
         }
+
+        double estimate = 0.709 * REGISTERS * REGISTERS / sum;
+        if (estimate <= 2.5 * REGISTERS && zeros > 0)
+            estimate = REGISTERS * log((double)REGISTERS / zeros);  // Linear counting for small sets
+        return (int)(estimate + 0.5);
     }
 
-    // Depth-First Search (DFS) for rerouting
-    void dfs(int start, bool visited[], int parent[])
+    void merge(const HyperLogLog &other)
     {
-        visited[start] = true;
+        for (int i = 0; i < REGISTERS; i++)
+            if (other.registers[i] > registers[i])
+                registers[i] = other.registers[i];
+    }
 
-        // Explore all the neighboring nodes
-        for (int i = 0; i < MAX_NODES; i++)
+    void clear()
+    {
+        for (int i = 0; i < REGISTERS; i++)
+            registers[i] = 0;
+    }
+};
+
+// Max-heap over a fixed set of IDs whose keys change in place
+// position[] maps an ID to its heap slot, so a changed key is sifted from where it is in O(log n).
+// top() reads the k largest in order without disturbing the heap, in O(k log k): the next largest
+// is always a child of one already taken, so only those children are candidates.
+template <int COUNT>
+class IndexedMaxHeap
+{
+private:
+    int heap[COUNT];     // IDs in heap order
+    int position[COUNT]; // Slot of each ID in heap[]
+    int key[COUNT];
+
+    // Larger key first; ties go to the lower ID so the order is stable
+    bool above(int a, int b) const
+    {
+        return key[a] > key[b] || (key[a] == key[b] && a < b);
+    }
+
+    void place(int slot, int id)
+    {
+        heap[slot] = id;
+        position[id] = slot;
+    }
+
+    void siftUp(int slot)
+    {
+        int id = heap[slot];
+        while (slot > 0 && above(id, heap[(slot - 1) / 2]))
         {
-            if (roads[start][i] == 1 && !visited[i])
-            {
-                parent[i] = start;
-                dfs(i, visited, parent);
-            }
+            place(slot, heap[(slot - 1) / 2]);
+            slot = (slot - 1) / 2;
         }
+        place(slot, id);
     }
 
-   
-    void printPath(int parent[], int end)
+    void siftDown(int slot)
     {
-        if (end == -1)
+        int id = heap[slot];
+        while (2 * slot + 1 < COUNT)
         {
-            return; // No path found
+            int child = 2 * slot + 1;
+            if (child + 1 < COUNT && above(heap[child + 1], heap[child]))
+                child++;
+            if (!above(heap[child], id))
+                break;
+            place(slot, heap[child]);
+            slot = child;
         }
+        place(slot, id);
+    }
 
-        printPath(parent, parent[end]);
-        cout << (char)(end + 'A') << " "; 
+public:
+    IndexedMaxHeap()
+    {
+        for (int id = 0; id < COUNT; id++)
+        {
+            key[id] = 0;
+            place(id, id);
+        }
     }
 
-    // Breadth-First Search (BFS) for rerouting
-    void bfs(int start)
+    void update(int id, int newKey)
     {
-        bool visited[MAX_NODES] = {false};
-        int parent[MAX_NODES] = {-1};
-        int queue[MAX_NODES];
-        int front = 0, rear = 0;
+        int old = key[id];
+        key[id] = newKey;
+        if (newKey > old)
+            siftUp(position[id]);
+        else if (newKey < old)
+            siftDown(position[id]);
+    }
 
-        visited[start] = true;
-        queue[rear++] = start;
+    int keyOf(int id) const
+    {
+        return key[id];
+    }
 
-        while (front != rear)
+    // The k IDs with the largest keys, largest first, stopping at keys below minKey; returns how many
+    int top(int k, int ids[], int minKey = INT_MIN) const
+    {
+        if (k > COUNT)
+            k = COUNT;
+
+        int candidates[2 * COUNT + 1]; // Heap slots, kept as a max-heap on their keys
+        int candidateCount = 0;
+        int taken = 0;
+        if (k > 0)
+            candidates[candidateCount++] = 0;
+
+        while (taken < k && candidateCount > 0)
         {
-            int node = queue[front++];
-            for (int i = 0; i < MAX_NODES; i++)
+            int slot = candidates[0];
+            if (key[heap[slot]] < minKey)
+                break;
+            ids[taken++] = heap[slot];
+
+            // Replace the taken slot by its children
+            candidates[0] = candidates[--candidateCount];
+            for (int i = 0; i < candidateCount;)
             {
-                if (roads[node][i] == 1 && !visited[i])
-                {
-                    visited[i] = true;
-                    parent[i] = node;
-                    queue[rear++] = i;
-                }
+                int best = i, left = 2 * i + 1, right = 2 * i + 2;
+                if (left < candidateCount && above(heap[candidates[left]], heap[candidates[best]]))
+                    best = left;
+                if (right < candidateCount && above(heap[candidates[right]], heap[candidates[best]]))
+                    best = right;
+                if (best == i)
+                    break;
+                int swap = candidates[i];
+                candidates[i] = candidates[best];
+                candidates[best] = swap;
+                i = best;
             }
-        }
-
-       
-        for (int i = 0; i < MAX_NODES; i++)
-        {
-            if (visited[i])
+            for (int child = 2 * slot + 1; child <= 2 * slot + 2 && child < COUNT; child++)
             {
-                cout << "Node " << (char)(i + 'A') << " can be reached, rerouted path: ";
-                printPath(parent, i);
-                cout << endl;
+                int i = candidateCount++;
+                candidates[i] = child;
+                while (i > 0 && above(heap[candidates[i]], heap[candidates[(i - 1) / 2]]))
+                {
+                    int swap = candidates[i];
+                    candidates[i] = candidates[(i - 1) / 2];
+                    candidates[(i - 1) / 2] = swap;
+                    i = (i - 1) / 2;
+                }
             }
         }
+        return taken;
     }
 };
 
-class PriorityQueue 
+class Traffic
 {
 public:
-    struct QueueNode 
+    static const int MAX_NODES = 26; // Number of nodes (A to Z)
+    static const int MAX_ROADS = MAX_NODES * MAX_NODES; // One counter per ordered pair of intersections
+    int roads[MAX_NODES][MAX_NODES];
+
+    static const int BATCH_LINES = 4096; // Trip lines read ahead at a time; a full batch is split across threads
+
+    // Vehicle counts over a sliding window of the simulation clock, in buckets of bucketMinutes
+    // Trips are counted into the open bucket; when the clock passes its end it is closed into a
+    // ring of the last bucketCount - 1 closed buckets, keeping a rolling sum and an EWMA per road.
+    // Memory is fixed by MAX_BUCKETS however long the simulation runs.
+    static const int MAX_BUCKETS = 32;
+    int bucketMinutes;
+    int bucketCount;   // Buckets in the window, the open one included
+    double ewmaAlpha;  // Weight of the newest bucket in the EWMA
+    int bucketStart;   // Clock minute the open bucket started at
+
+    ShardedCounters<MAX_ROADS> openBucket;   // Vehicles counted on each road in the open bucket, indexed by road ID
+    int closedBuckets[MAX_BUCKETS][MAX_ROADS];
+    int oldestBucket;                        // Ring slot the next closed bucket replaces
+    int windowSum[MAX_ROADS];                // Sum of the closed buckets in the window
+    double ewma[MAX_ROADS];                  // Vehicles per bucket, smoothed over closed buckets
+
+    // Optional sketch mode for city-wide feeds, where exact per-vehicle data would grow without bound:
+    // trips of each vehicle per road in a Count-Min sketch, distinct vehicles per road and per
+    // intersection in HyperLogLogs. Ingestion threads fill their own shard for the open bucket;
+    // closing the bucket merges the shards into a ring of per-bucket sketches that parallels
+    // closedBuckets, so reads cover the same window as the exact counts.
+    struct TrafficSketch
     {
-        char vertex;
-        int distance;
-    };
+        CountMinSketch vehicleTrips;  // Keyed by tripKey(vehicle, road)
+        HyperLogLog roadVehicles[MAX_ROADS];
+        HyperLogLog intersectionVehicles[MAX_NODES];
 
-private:
-    QueueNode *heap;
-    int capacity;
-    int size;
+        void merge(const TrafficSketch &other)
+        {
+            vehicleTrips.merge(other.vehicleTrips);
+            for (int id = 0; id < MAX_ROADS; id++)
+                roadVehicles[id].merge(other.roadVehicles[id]);
+            for (int i = 0; i < MAX_NODES; i++)
+                intersectionVehicles[i].merge(other.intersectionVehicles[i]);
+        }
 
-    void heapifyUp(int index) 
-    {
-        while (index > 0 && heap[index].distance < heap[(index - 1) / 2].distance) 
+        void clear()
         {
-            QueueNode temp = heap[index];
-            heap[index] = heap[(index - 1) / 2];
-            heap[(index - 1) / 2] = temp;
-            index = (index - 1) / 2;
+            vehicleTrips.clear();
+            for (int id = 0; id < MAX_ROADS; id++)
+                roadVehicles[id].clear();
+            for (int i = 0; i < MAX_NODES; i++)
+                intersectionVehicles[i].clear();
         }
-    }
+    };
 
-    void heapifyDown(int index) 
-    {
-        int smallest = index;
-        int left = 2 * index + 1;
-        int right = 2 * index + 2;
+    static const int SKETCH_SHARDS = 4;
+    static const long long SKETCH_BYTES = 1 << 20; // Trip files this large (about 65536 trips) switch sketch mode on
+    TrafficSketch *sketchShards;  // SKETCH_SHARDS shards for the open bucket (nullptr unless sketching)
+    TrafficSketch *sketchRing;    // One sketch per closed bucket in the window (bucketCount - 1)
 
-        if (left < size && heap[left].distance < heap[smallest].distance)
-            smallest = left;
+    static unsigned long long tripKey(unsigned long long vehicleHash, int id)
+    {
+        return mixHash(vehicleHash ^ ((unsigned long long)id << 32));
+    }
 
-        if (right < size && heap[right].distance < heap[smallest].distance)
-            smallest = right;
+    // Roads ranked by windowed count; roads whose count changed are queued and re-ranked on the next read
+    IndexedMaxHeap<MAX_ROADS> ranking;
+    unsigned char rankStale[MAX_ROADS];
+    int staleRoads[MAX_ROADS];
+    int staleCount;
 
-        if (smallest != index) 
-        {
-            QueueNode temp = heap[index];
-            heap[index] = heap[smallest];
-            heap[smallest] = temp;
-            heapifyDown(smallest);
-        }
+    // Road ID of the road from one intersection to another
+    int roadId(char from, char to)
+    {
+        return getNodeIndex(from) * MAX_NODES + getNodeIndex(to);
     }
 
-public:
-    PriorityQueue(int capacity) : capacity(capacity), size(0) 
+    // Increasing the vehicle count for a road
+    void updateRoadCount(int id)
     {
-        heap = new QueueNode[capacity];
+        openBucket.add(id, 1);
+        markRankStale(id);
     }
 
-    void insert(char vertex, int distance) 
+    // Queue a road for re-ranking, once until the next read; safe from several threads
+    void markRankStale(int id)
     {
-        heap[size] = {vertex, distance};
-        heapifyUp(size);
-        size++;
+        if (!__atomic_load_n(&rankStale[id], __ATOMIC_RELAXED) && !__atomic_exchange_n(&rankStale[id], 1, __ATOMIC_RELAXED))
+        {
+            staleRoads[__atomic_fetch_add(&staleCount, 1, __ATOMIC_RELAXED)] = id;
+        }
     }
 
-    QueueNode extractMin() 
+    // The k most congested roads by windowed count, most congested first, leaving out empty roads;
+    // returns how many. Only roads counted since the last call are re-ranked
+    int topCongested(int k, int ids[])
     {
-        QueueNode minNode = heap[0];
-        heap[0] = heap[size - 1];
-        size--;
-        heapifyDown(0);
-        return minNode;
+        for (int i = 0; i < staleCount; i++)
+        {
+            int id = staleRoads[i];
+            rankStale[id] = 0;
+            ranking.update(id, windowCount(id));
+        }
+        staleCount = 0;
+        return ranking.top(k, ids, 1);
     }
 
-    bool isEmpty() 
+    // Vehicles on a road within the window
+    int windowCount(int id) const
     {
-        return size == 0;
+        return windowSum[id] + openBucket.value(id);
     }
-};
 
-// representing the roads bw intersections as egdes
-// travel time is weights
+    // Close the open bucket into the ring; not safe while trips are being ingested
+    void closeBucket()
+    {
+        int ringSize = bucketCount - 1;
+        for (int id = 0; id < MAX_ROADS; id++)
+        {
+            int count = openBucket.value(id);
+            int dropped = count;  // What leaves the window
+            if (ringSize > 0)
+            {
+                dropped = closedBuckets[oldestBucket][id];
+                windowSum[id] += count - dropped;
+                closedBuckets[oldestBucket][id] = count;
+            }
+            if (dropped != 0)
+            {
+                markRankStale(id);
+            }
+            ewma[id] = ewmaAlpha * count + (1 - ewmaAlpha) * ewma[id];
+        }
+        openBucket.clear();
 
-// next pointer:used to point to the next edge in adjacency list
+        // The open bucket's sketch replaces the one leaving the window
+        if (sketching())
+        {
+            if (ringSize > 0)
+            {
+                sketchRing[oldestBucket].clear();
+            }
+            for (int s = 0; s < SKETCH_SHARDS; s++)
+            {
+                if (ringSize > 0)
+                {
+                    sketchRing[oldestBucket].merge(sketchShards[s]);
+                }
+                sketchShards[s].clear();
+            }
+        }
+
+        if (ringSize > 0)
+        {
+            oldestBucket = (oldestBucket + 1) % ringSize;
+        }
+    }
+
+    // Move the window up to a clock minute, closing every bucket that ended by then
+    void advanceTo(int minute)
+    {
+        int elapsed = (minute - bucketStart) / bucketMinutes;
+        if (elapsed <= 0)
+        {
+            return;
+        }
+
+        // After a full window of closes every bucket is empty; the rest only decays the EWMA
+        for (int i = 0; i < elapsed && i < bucketCount; i++)
+        {
+            closeBucket();
+        }
+        if (elapsed > bucketCount)
+        {
+            double decay = pow(1 - ewmaAlpha, elapsed - bucketCount);
+            for (int id = 0; id < MAX_ROADS; id++)
+            {
+                ewma[id] *= decay;
+            }
+        }
+        bucketStart += elapsed * bucketMinutes;
+    }
+
+    // Change the window shape; counts so far are discarded
+    bool configureWindow(int minutes, int buckets, double alpha)
+    {
+        if (minutes < 1 || buckets < 1 || buckets > MAX_BUCKETS || alpha <= 0 || alpha > 1)
+        {
+            return false;
+        }
+
+        bucketMinutes = minutes;
+        bucketCount = buckets;
+        ewmaAlpha = alpha;
+        oldestBucket = 0;
+        openBucket.clear();
+        for (int id = 0; id < MAX_ROADS; id++)
+        {
+            for (int b = 0; b < MAX_BUCKETS; b++)
+            {
+                closedBuckets[b][id] = 0;
+            }
+            windowSum[id] = 0;
+            ewma[id] = 0;
+            markRankStale(id);
+        }
+
+        if (sketching())
+        {
+            delete[] sketchRing;
+            sketchRing = buckets > 1 ? new TrafficSketch[buckets - 1] : nullptr;
+            for (int s = 0; s < SKETCH_SHARDS; s++)
+            {
+                sketchShards[s].clear();
+            }
+        }
+        return true;
+    }
+
+
+    Traffic()
+    {
+        for (int i = 0; i < MAX_NODES; i++)
+        {
+            for (int j = 0; j < MAX_NODES; j++)
+            {
+                roads[i][j] = 0;
+            }
+        }
+        for (int id = 0; id < MAX_ROADS; id++)
+        {
+            rankStale[id] = 0;
+        }
+        staleCount = 0;
+        bucketStart = 0;
+        sketchShards = nullptr;
+        sketchRing = nullptr;
+        configureWindow(5, 12, 0.3);  // One hour in 5-minute buckets
+    }
+
+    ~Traffic()
+    {
+        delete[] sketchShards;
+        delete[] sketchRing;
+    }
+
+    Traffic(const Traffic &) = delete;
+    Traffic &operator=(const Traffic &) = delete;
+
+    // Switch sketch mode on; only trips ingested from now on are sketched
+    void enableSketches()
+    {
+        if (sketchShards == nullptr)
+        {
+            sketchShards = new TrafficSketch[SKETCH_SHARDS];
+            sketchRing = bucketCount > 1 ? new TrafficSketch[bucketCount - 1] : nullptr;
+        }
+    }
+
+    bool sketching() const
+    {
+        return sketchShards != nullptr;
+    }
+
+    // Sketches covering the window: the closed buckets' ring, then the open bucket's shards
+    int windowSketchCount() const
+    {
+        return bucketCount - 1 + SKETCH_SHARDS;
+    }
+
+    const TrafficSketch &windowSketch(int i) const
+    {
+        return i < bucketCount - 1 ? sketchRing[i] : sketchShards[i - (bucketCount - 1)];
+    }
+
+    // Estimated distinct vehicles on a road within the window (0 without sketches)
+    int distinctVehicles(int id) const
+    {
+        if (!sketching())
+        {
+            return 0;
+        }
+        HyperLogLog merged;
+        for (int i = 0; i < windowSketchCount(); i++)
+        {
+            merged.merge(windowSketch(i).roadVehicles[id]);
+        }
+        return merged.estimate();
+    }
+
+    // Estimated distinct vehicles starting or ending at an intersection within the window (0 without sketches)
+    int distinctVehiclesAt(char intersection) const
+    {
+        if (!sketching())
+        {
+            return 0;
+        }
+        HyperLogLog merged;
+        for (int i = 0; i < windowSketchCount(); i++)
+        {
+            merged.merge(windowSketch(i).intersectionVehicles[getNodeIndex(intersection)]);
+        }
+        return merged.estimate();
+    }
+
+    // Estimated trips a vehicle made over a road within the window (never less than the true count; 0 without sketches)
+    int vehicleTrips(const string &vehicleID, int id) const
+    {
+        if (!sketching())
+        {
+            return 0;
+        }
+        // Counters add up across sketches, so the estimate of the merge is the smallest row sum
+        unsigned long long key = tripKey(hashKey(vehicleID), id);
+        int best = INT_MAX;
+        for (int row = 0; row < CountMinSketch::DEPTH; row++)
+        {
+            int sum = 0;
+            for (int i = 0; i < windowSketchCount(); i++)
+            {
+                sum += windowSketch(i).vehicleTrips.count(key, row);
+            }
+            if (sum < best)
+                best = sum;
+        }
+        // A vehicle cannot have made more trips over a road than the road saw
+        return best < windowCount(id) ? best : windowCount(id);
+    }
+
+    int getNodeIndex(char node) const
+    {
+        return node - 'A';
+    }
+
+    
+    // Count one trip line (vehicle,start,end); safe to call from several threads at once
+    void ingestTrip(const string &line)
+    {
+        stringstream ss(line);
+        string vehicleID, start, end;
+        getline(ss, vehicleID, ',');
+        getline(ss, start, ',');
+        getline(ss, end, ',');
+
+        __atomic_store_n(&roads[getNodeIndex(start[0])][getNodeIndex(end[0])], 1, __ATOMIC_RELAXED);
+
+        TrafficSketch *sketch = sketching() ? &sketchShards[threadSlot() % SKETCH_SHARDS] : nullptr;
+        unsigned long long vehicleHash = sketch != nullptr ? hashKey(vehicleID) : 0;
+        if (sketch != nullptr)
+        {
+            sketch->intersectionVehicles[getNodeIndex(start[0])].add(vehicleHash);
+            sketch->intersectionVehicles[getNodeIndex(end[0])].add(vehicleHash);
+        }
+
+        for (char curNode = start[0]; curNode != end[0];)
+        {
+            char nextNode = curNode + 1;
+            if (nextNode > end[0])
+                break;
+            int id = roadId(curNode, nextNode);
+            updateRoadCount(id);
+            if (sketch != nullptr)
+            {
+                sketch->roadVehicles[id].add(vehicleHash);
+                sketch->vehicleTrips.add(tripKey(vehicleHash, id), 1);
+            }
+            curNode = nextNode;
+        }
+    }
+
+    // Count a batch of trip lines, split across threads when the batch is full
+    void ingestBatch(const string lines[], int lineCount)
+    {
+        int threadCount = lineCount >= BATCH_LINES ? (int)thread::hardware_concurrency() : 1;
+        if (threadCount < 1)
+            threadCount = 1;
+        if (threadCount > 8)
+            threadCount = 8;
+
+        if (threadCount == 1)
+        {
+            for (int i = 0; i < lineCount; i++)
+                ingestTrip(lines[i]);
+            return;
+        }
+
+        // Each thread counts into its own shard
+        thread *workers = new thread[threadCount];
+        for (int t = 0; t < threadCount; ++t)
+        {
+            workers[t] = thread([this, lines, lineCount, t, threadCount]()
+            {
+                for (int i = t; i < lineCount; i += threadCount)
+                    ingestTrip(lines[i]);
+            });
+        }
+        for (int t = 0; t < threadCount; ++t)
+        {
+            workers[t].join();
+        }
+        delete[] workers;
+    }
+
+    // Stream a trip file in batches, so memory stays the same however long the feed is
+    void loadData(const string &filename)
+    {
+        ifstream file(filename);
+        if (!file.is_open())
+        {
+            cerr << "Error: Unable to open file!" << endl;
+            return;
+        }
+
+        // A city-wide feed is sketched from the start; its size is known without reading it
+        file.seekg(0, ios::end);
+        if ((long long)file.tellg() >= SKETCH_BYTES)
+        {
+            enableSketches();
+        }
+        file.seekg(0, ios::beg);
+
+        string line;
+        getline(file, line); // Skip header
+
+        string *batch = new string[BATCH_LINES];
+        int batchCount = 0;
+        while (getline(file, batch[batchCount]))
+        {
+            if (++batchCount == BATCH_LINES)
+            {
+                ingestBatch(batch, batchCount);
+                batchCount = 0;
+            }
+        }
+        ingestBatch(batch, batchCount);
+        delete[] batch;
+        file.close();
+    }
+
+  
+    void showCongestion()
+    {
+        bool congestionFound = false;
+        cout << "------ Congestion Status (last " << bucketMinutes * bucketCount << " min) ------" << endl;
+        const int threshold = 3;
+
+        // Roads with vehicles, busiest first, straight from the ranking
+        int ranked[MAX_ROADS];
+        int rankedCount = topCongested(MAX_ROADS, ranked);
+        for (int r = 0; r < rankedCount; r++)
+        {
+            int id = ranked[r];
+            int count = ranking.keyOf(id);
+
+            cout << (char)(id / MAX_NODES + 'A') << " to " << (char)(id % MAX_NODES + 'A') << " -> Vehicles: " << count;
+            int trend = (int)(ewma[id] * 10 + 0.5);  // Tenths of a vehicle per bucket
+            if (trend > 0)
+            {
+                cout << ", trend " << trend / 10 << "." << trend % 10 << " per " << bucketMinutes << " min";
+            }
+            if (sketching())
+            {
+                cout << ", ~" << distinctVehicles(id) << " distinct vehicles";
+            }
+            if (count >= threshold)
+            {
+                cout << " (Congested)";
+                congestionFound = true;
+            }
+            cout << endl;
+        }
+
+        if (!congestionFound)
+        {
+            cout << "No congested roads detected." << endl;
+        }
+
+        if (sketching())
+        {
+            cout << "Distinct vehicles starting or ending at each intersection:" << endl;
+            for (int i = 0; i < MAX_NODES; i++)
+            {
+                int distinct = distinctVehiclesAt(i + 'A');
+                if (distinct > 0)
+                {
+                    cout << (char)(i + 'A') << " -> ~" << distinct << endl;
+                }
+            }
+        }
+    }
+
+    // Estimated trips of a vehicle over one road within the window, from the Count-Min sketch
+    void showVehicleTrips(const string &vehicleID, char start, char end) const
+    {
+        if (start < 'A' || start - 'A' >= MAX_NODES || end < 'A' || end - 'A' >= MAX_NODES)
+        {
+            cout << "Invalid intersections!" << endl;
+            return;
+        }
+        int id = (start - 'A') * MAX_NODES + (end - 'A');
+        cout << vehicleID << " on " << start << " to " << end << " -> at most ~" << vehicleTrips(vehicleID, id)
+             << " trips (out of " << windowCount(id) << " on the road)" << endl;
+    }
+
+    // Depth-First Search (DFS) for rerouting
+    void dfs(int start, bool visited[], int parent[])
+    {
+        visited[start] = true;
+
+        // Explore all the neighboring nodes
+        for (int i = 0; i < MAX_NODES; i++)
+        {
+            if (roads[start][i] == 1 && !visited[i])
+            {
+                parent[i] = start;
+                dfs(i, visited, parent);
+            }
+        }
+    }
+
+   
+    void printPath(int parent[], int end)
+    {
+        if (end == -1)
+        {
+            return; // No path found
+        }
+
+        printPath(parent, parent[end]);
+        cout << (char)(end + 'A') << " "; 
+    }
+
+    // Breadth-First Search (BFS) for rerouting
+    void bfs(int start)
+    {
+        bool visited[MAX_NODES] = {false};
+        int parent[MAX_NODES] = {-1};
+        int queue[MAX_NODES];
+        int front = 0, rear = 0;
+
+        visited[start] = true;
+        queue[rear++] = start;
+
+        while (front != rear)
+        {
+            int node = queue[front++];
+            for (int i = 0; i < MAX_NODES; i++)
+            {
+                if (roads[node][i] == 1 && !visited[i])
+                {
+                    visited[i] = true;
+                    parent[i] = node;
+                    queue[rear++] = i;
+                }
+            }
+        }
+
+       
+        for (int i = 0; i < MAX_NODES; i++)
+        {
+            if (visited[i])
+            {
+                cout << "Node " << (char)(i + 'A') << " can be reached, rerouted path: ";
+                printPath(parent, i);
+                cout << endl;
+            }
+        }
+    }
+};
+
+class PriorityQueue 
+{
+public:
+    struct QueueNode 
+    {
+        char vertex;
+        int distance;
+    };
+
+private:
+    QueueNode *heap;
+    int capacity;
+    int size;
+
+    void heapifyUp(int index) 
+    {
+        while (index > 0 && heap[index].distance < heap[(index - 1) / 2].distance) 
+        {
+            QueueNode temp = heap[index];
+            heap[index] = heap[(index - 1) / 2];
+            heap[(index - 1) / 2] = temp;
+            index = (index - 1) / 2;
+        }
+    }
+
+    void heapifyDown(int index) 
+    {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = 2 * index + 2;
+
+        if (left < size && heap[left].distance < heap[smallest].distance)
+            smallest = left;
+
+        if (right < size && heap[right].distance < heap[smallest].distance)
+            smallest = right;
+
+        if (smallest != index) 
+        {
+            QueueNode temp = heap[index];
+            heap[index] = heap[smallest];
+            heap[smallest] = temp;
+            heapifyDown(smallest);
+        }
+    }
+
+public:
+    PriorityQueue(int capacity) : capacity(capacity), size(0) 
+    {
+        heap = new QueueNode[capacity];
+    }
+
+    ~PriorityQueue() 
+    {
+        delete[] heap;
+    }
+
+    void insert(char vertex, int distance) 
+    {
+        heap[size] = {vertex, distance};
+        heapifyUp(size);
+        size++;
+    }
+
+    QueueNode extractMin() 
+    {
+        QueueNode minNode = heap[0];
+        heap[0] = heap[size - 1];
+        size--;
+        heapifyDown(0);
+        return minNode;
+    }
+
+    bool isEmpty() 
+    {
+        return size == 0;
+    }
+};
+
+// Fixed-size bitset over intersections or edge IDs
+// Used for reachability sets so many of them can be combined with word-wide unions/intersections
+class Bitset
+{
+public:
+    static const int MAX_BITS = 1024;
+    static const int WORDS = MAX_BITS / 64;
+
+private:
+    unsigned long long words[WORDS];
+
+public:
+    Bitset()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        for (int i = 0; i < WORDS; i++)
+            words[i] = 0;
+    }
+
+    void set(int bit)
+    {
+        words[bit >> 6] |= 1ULL << (bit & 63);
+    }
+
+    void reset(int bit)
+    {
+        words[bit >> 6] &= ~(1ULL << (bit & 63));
+    }
+
+    bool test(int bit) const
+    {
+        return (words[bit >> 6] >> (bit & 63)) & 1ULL;
+    }
+
+    // Thread-safe single-bit flips for sets that are updated while searches read them
+    void atomicSet(int bit)
+    {
+        __atomic_fetch_or(&words[bit >> 6], 1ULL << (bit & 63), __ATOMIC_RELEASE);
+    }
+
+    void atomicReset(int bit)
+    {
+        __atomic_fetch_and(&words[bit >> 6], ~(1ULL << (bit & 63)), __ATOMIC_RELEASE);
+    }
+
+    bool atomicTest(int bit) const
+    {
+        return (__atomic_load_n(&words[bit >> 6], __ATOMIC_ACQUIRE) >> (bit & 63)) & 1ULL;
+    }
+
+    void unionWith(const Bitset &other)
+    {
+        for (int i = 0; i < WORDS; i++)
+            words[i] |= other.words[i];
+    }
+
+    void intersectWith(const Bitset &other)
+    {
+        for (int i = 0; i < WORDS; i++)
+            words[i] &= other.words[i];
+    }
+
+    int count() const
+    {
+        int total = 0;
+        for (int i = 0; i < WORDS; i++)
+            total += __builtin_popcountll(words[i]);
+        return total;
+    }
+};
+
+// Open-addressing hash index from a key to an int (usually a position in one of the fixed arrays)
+// Robin Hood probing: an entry that has travelled further from its home slot takes the place of
+// one that has not, so probe lengths stay short and a miss stops as soon as it passes entries
+// closer to home than itself. The table doubles when it is 7/8 full.
+template <typename Key>
+class HashIndex
+{
+private:
+    struct Slot
+    {
+        Key key;
+        int value;
+        unsigned int hash;     // Low bits of the key hash, compared before the key
+        unsigned int distance; // Probe length + 1; 0 marks an empty slot
+    };
+
+    Slot *slots;
+    int capacity; // Power of two
+    int count;
+
+    void grow()
+    {
+        Slot *old = slots;
+        int oldCapacity = capacity;
+
+        capacity *= 2;
+        slots = new Slot[capacity];
+        for (int i = 0; i < capacity; i++)
+            slots[i].distance = 0;
+        count = 0;
+
+        for (int i = 0; i < oldCapacity; i++)
+        {
+            if (old[i].distance != 0)
+                place(old[i].key, old[i].value, old[i].hash);
+        }
+        delete[] old;
+    }
+
+    // Insert a key known to be absent
+    void place(Key key, int value, unsigned int hash)
+    {
+        Slot entry = {key, value, hash, 1};
+        int mask = capacity - 1;
+        for (int i = hash & mask;; i = (i + 1) & mask)
+        {
+            if (slots[i].distance == 0)
+            {
+                slots[i] = entry;
+                count++;
+                return;
+            }
+            if (slots[i].distance < entry.distance)
+            {
+                Slot displaced = slots[i];
+                slots[i] = entry;
+                entry = displaced;
+            }
+            entry.distance++;
+        }
+    }
+
+public:
+    HashIndex(int initialCapacity = 64) : capacity(16), count(0)
+    {
+        while (capacity < initialCapacity)
+            capacity *= 2;
+        slots = new Slot[capacity];
+        for (int i = 0; i < capacity; i++)
+            slots[i].distance = 0;
+    }
+
+    ~HashIndex()
+    {
+        delete[] slots;
+    }
+
+    HashIndex(const HashIndex &) = delete;
+    HashIndex &operator=(const HashIndex &) = delete;
+
+    // Value stored for key, or -1 if it is absent
+    int find(const Key &key) const
+    {
+        unsigned int hash = (unsigned int)hashKey(key);
+        int mask = capacity - 1;
+        unsigned int distance = 1;
+        for (int i = hash & mask; slots[i].distance >= distance; i = (i + 1) & mask, distance++)
+        {
+            if (slots[i].hash == hash && slots[i].key == key)
+                return slots[i].value;
+        }
+        return -1;
+    }
+
+    // Set the value of key, adding it if it is absent
+    void set(const Key &key, int value)
+    {
+        unsigned int hash = (unsigned int)hashKey(key);
+        int mask = capacity - 1;
+        unsigned int distance = 1;
+        for (int i = hash & mask; slots[i].distance >= distance; i = (i + 1) & mask, distance++)
+        {
+            if (slots[i].hash == hash && slots[i].key == key)
+            {
+                slots[i].value = value;
+                return;
+            }
+        }
+
+        if ((count + 1) * 8 > capacity * 7)
+            grow();
+        place(key, value, hash);
+    }
+
+    void clear()
+    {
+        for (int i = 0; i < capacity; i++)
+        {
+            if (slots[i].distance != 0)
+            {
+                slots[i].key = Key();
+                slots[i].distance = 0;
+            }
+        }
+        count = 0;
+    }
+
+    int size() const
+    {
+        return count;
+    }
+};
+
+// Edge relaxation kernels
+// Relax a contiguous block of edges leaving a node at distance base: every edge whose base + weight
+// beats dist[target] lowers it and has its position written to improved[]. Returns the number written.
+// The vector versions gather the tentative distances, add and compare a whole register at once, then
+// scatter the winners one by one so parallel edges to the same target resolve exactly like the scalar loop.
+typedef int (*RelaxKernel)(int base, const int *targets, const int *weights, int count, int *dist, int *improved);
+
+static int relaxScalar(int base, const int *targets, const int *weights, int count, int *dist, int *improved)
+{
+    int k = 0;
+    for (int i = 0; i < count; i++)
+    {
+        int newDist = base + weights[i];
+        if (newDist < dist[targets[i]])
+        {
+            dist[targets[i]] = newDist;
+            improved[k++] = i;
+        }
+    }
+    return k;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2")))
+static int relaxAvx2(int base, const int *targets, const int *weights, int count, int *dist, int *improved)
+{
+    __m256i baseVec = _mm256_set1_epi32(base);
+    int i = 0, k = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i targetVec = _mm256_loadu_si256((const __m256i *)(targets + i));
+        __m256i newDist = _mm256_add_epi32(baseVec, _mm256_loadu_si256((const __m256i *)(weights + i)));
+        __m256i oldDist = _mm256_i32gather_epi32(dist, targetVec, 4);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(oldDist, newDist)));
+
+        while (mask)
+        {
+            int j = i + __builtin_ctz(mask);
+            mask &= mask - 1;
+            if (base + weights[j] < dist[targets[j]])
+            {
+                dist[targets[j]] = base + weights[j];
+                improved[k++] = j;
+            }
+        }
+    }
+    for (; i < count; i++)
+    {
+        if (base + weights[i] < dist[targets[i]])
+        {
+            dist[targets[i]] = base + weights[i];
+            improved[k++] = i;
+        }
+    }
+    return k;
+}
+
+__attribute__((target("avx512f")))
+static int relaxAvx512(int base, const int *targets, const int *weights, int count, int *dist, int *improved)
+{
+    __m512i baseVec = _mm512_set1_epi32(base);
+    int i = 0, k = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m512i targetVec = _mm512_loadu_si512((const void *)(targets + i));
+        __m512i newDist = _mm512_add_epi32(baseVec, _mm512_loadu_si512((const void *)(weights + i)));
+        __m512i oldDist = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), (__mmask16)0xFFFF, targetVec, dist, 4);
+        unsigned int mask = _mm512_cmplt_epi32_mask(newDist, oldDist);
+
+        while (mask)
+        {
+            int j = i + __builtin_ctz(mask);
+            mask &= mask - 1;
+            if (base + weights[j] < dist[targets[j]])
+            {
+                dist[targets[j]] = base + weights[j];
+                improved[k++] = j;
+            }
+        }
+    }
+    int tail = relaxScalar(base, targets + i, weights + i, count - i, dist, improved + k);
+    for (int t = k; t < k + tail; t++)
+    {
+        improved[t] += i;  // Tail positions are relative to i
+    }
+    return k + tail;
+}
+#endif
+
+// Pick the widest kernel the CPU supports, once at startup
+static RelaxKernel selectRelaxKernel()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return relaxAvx512;
+    if (__builtin_cpu_supports("avx2"))
+        return relaxAvx2;
+#endif
+    return relaxScalar;
+}
+
+static const RelaxKernel relaxEdges = selectRelaxKernel();
+
+static const int SEARCH_UNREACHABLE = 999999;  // Distance of nodes no route reaches
+static const int SIMD_MIN_DEGREE = 8;          // Nodes with fewer edges are relaxed with the plain loop
+
+// Contiguous adjacency a Router searches: edges of node u are [offset[u], offset[u + 1])
+template <typename Weight>
+struct SearchGraph
+{
+    int nodeCount;
+    const int *offset;
+    const int *target;
+    const int *edgeId;
+    const Weight *weight;
+};
+
+// Router queue policies: push(node, key), popMin(key), empty(), clear()
+
+// Binary min-heap, works with any key order
+class BinaryHeapQueue
+{
+private:
+    int *nodes;
+    int *keys;
+    int capacity;
+    int size;
+
+public:
+    BinaryHeapQueue(int capacity) : capacity(capacity), size(0)
+    {
+        nodes = new int[capacity];
+        keys = new int[capacity];
+    }
+
+    ~BinaryHeapQueue()
+    {
+        delete[] nodes;
+        delete[] keys;
+    }
+
+    void clear()
+    {
+        size = 0;
+    }
+
+    bool empty() const
+    {
+        return size == 0;
+    }
+
+    void push(int node, int key)
+    {
+        if (size == capacity)
+            return;
+
+        int index = size++;
+        while (index > 0 && key < keys[(index - 1) / 2])
+        {
+            nodes[index] = nodes[(index - 1) / 2];
+            keys[index] = keys[(index - 1) / 2];
+            index = (index - 1) / 2;
+        }
+        nodes[index] = node;
+        keys[index] = key;
+    }
+
+    int popMin(int &key)
+    {
+        int node = nodes[0];
+        key = keys[0];
+
+        int lastNode = nodes[--size];
+        int lastKey = keys[size];
+        int index = 0;
+        while (2 * index + 1 < size)
+        {
+            int child = 2 * index + 1;
+            if (child + 1 < size && keys[child + 1] < keys[child])
+                child++;
+            if (keys[child] >= lastKey)
+                break;
+            nodes[index] = nodes[child];
+            keys[index] = keys[child];
+            index = child;
+        }
+        nodes[index] = lastNode;
+        keys[index] = lastKey;
+        return node;
+    }
+};
+
+// Radix heap for monotone integer keys (never below the last popped key), so only with a zero heuristic
+// Items sit in buckets by the highest bit where their key differs from the last popped key
+class RadixQueue
+{
+private:
+    static const int BUCKETS = 33;
+
+    int *itemNode;
+    int *itemKey;
+    int *itemNext;
+    int freeItem;
+    int head[BUCKETS];
+    int last;
+    int size;
+
+    static int bucketOf(int key, int last)
+    {
+        return key == last ? 0 : 32 - __builtin_clz((unsigned int)(key ^ last));
+    }
+
+    void link(int item)
+    {
+        int bucket = bucketOf(itemKey[item], last);
+        itemNext[item] = head[bucket];
+        head[bucket] = item;
+    }
+
+public:
+    RadixQueue(int capacity)
+    {
+        itemNode = new int[capacity];
+        itemKey = new int[capacity];
+        itemNext = new int[capacity];
+        for (int i = 0; i < capacity; i++)
+            itemNext[i] = (i + 1 < capacity) ? i + 1 : -1;
+        freeItem = 0;
+        for (int b = 0; b < BUCKETS; b++)
+            head[b] = -1;
+        last = 0;
+        size = 0;
+    }
+
+    ~RadixQueue()
+    {
+        delete[] itemNode;
+        delete[] itemKey;
+        delete[] itemNext;
+    }
+
+    void clear()
+    {
+        while (size > 0)
+        {
+            int key;
+            popMin(key);
+        }
+        last = 0;
+    }
+
+    bool empty() const
+    {
+        return size == 0;
+    }
+
+    void push(int node, int key)
+    {
+        if (freeItem == -1)
+            return;
+
+        int item = freeItem;
+        freeItem = itemNext[item];
+        itemNode[item] = node;
+        itemKey[item] = key < last ? last : key;
+        link(item);
+        size++;
+    }
+
+    int popMin(int &key)
+    {
+        if (head[0] == -1)
+        {
+            // Refill bucket 0 from the first non-empty bucket, re-bucketing around its minimum
+            int b = 1;
+            while (head[b] == -1)
+                b++;
+
+            int minKey = itemKey[head[b]];
+            for (int item = head[b]; item != -1; item = itemNext[item])
+                if (itemKey[item] < minKey)
+                    minKey = itemKey[item];
+
+            last = minKey;
+            int item = head[b];
+            head[b] = -1;
+            while (item != -1)
+            {
+                int next = itemNext[item];
+                link(item);
+                item = next;
+            }
+        }
+
+        int item = head[0];
+        head[0] = itemNext[item];
+        itemNext[item] = freeItem;
+        freeItem = item;
+        size--;
+
+        key = itemKey[item];
+        return itemNode[item];
+    }
+};
+
+// Connected components of the open road network, for rejecting unreachable trips without a search
+// Components come from a union-find over the open roads. Opening a road is a union; closing one only
+// forces a rebuild if it was one of the spanning forest edges that joined two components, since any
+// other edge's endpoints stay connected through the forest. Roads count in both directions here, so
+// the components may over-approximate reachability but never split a reachable pair.
+class ConnectivityIndex
+{
+public:
+    static const int MAX_NODES = 100;
+
+private:
+    int parent[MAX_NODES];
+    Bitset forestEdges;  // Edges that joined two components, keyed as the owner chooses
+    bool stale = true;
+
+    int find(int node)
+    {
+        while (parent[node] != node)
+        {
+            parent[node] = parent[parent[node]];  // Path halving
+            node = parent[node];
+        }
+        return node;
+    }
+
+public:
+    bool isStale() const
+    {
+        return stale;
+    }
+
+    void markStale()
+    {
+        stale = true;
+    }
+
+    // Start over with every node on its own; the owner then adds every open edge
+    void reset(int nodeCount)
+    {
+        for (int i = 0; i < nodeCount && i < MAX_NODES; ++i)
+        {
+            parent[i] = i;
+        }
+        forestEdges.clear();
+        stale = false;
+    }
+
+    void edgeAdded(int key, int u, int v)
+    {
+        if (stale)
+        {
+            return;  // Picked up by the next rebuild
+        }
+        int rootU = find(u), rootV = find(v);
+        if (rootU != rootV)
+        {
+            parent[rootU] = rootV;
+            forestEdges.set(key);
+        }
+    }
+
+    void edgeRemoved(int key)
+    {
+        if (forestEdges.test(key))
+        {
+            stale = true;
+        }
+    }
+
+    // False only if no route can join the two nodes
+    bool connected(int u, int v)
+    {
+        return find(u) == find(v);
+    }
+};
+
+// Temporary changes layered over the base weights: per-edge slowdowns and closed intersections
+// Slowdowns are extra percent of travel time and add up, so stacking or lifting one incident is O(1)
+// and exact. Searches apply the overlay while relaxing edges; base weights are never touched.
+class WeightOverlay
+{
+public:
+    static const int MAX_EDGES = 1024;
+    static const int MAX_NODES = 100;
+    static const int MAX_EXTRA_PERCENT = 10000;
+
+private:
+    int extraPercent[MAX_EDGES];
+    unsigned char nodeClosures[MAX_NODES];
+    int activeEntries = 0;  // Edges with a slowdown plus closed intersections
+
+public:
+    WeightOverlay()
+    {
+        for (int i = 0; i < MAX_EDGES; ++i)
+            extraPercent[i] = 0;
+        for (int i = 0; i < MAX_NODES; ++i)
+            nodeClosures[i] = 0;
+    }
+
+    bool isEmpty() const
+    {
+        return activeEntries == 0;
+    }
+
+    // Add (or with a negative percent, lift) a slowdown of an edge
+    bool addSlowdown(int edgeId, int percent)
+    {
+        int extra = extraPercent[edgeId] + percent;
+        if (extra < 0 || extra > MAX_EXTRA_PERCENT)
+        {
+            return false;
+        }
+        activeEntries += (extra != 0) - (extraPercent[edgeId] != 0);
+        extraPercent[edgeId] = extra;
+        return true;
+    }
+
+    // Closures of an intersection stack; it reopens when the last one is lifted
+    bool setNodeClosed(int node, bool closed)
+    {
+        if (closed)
+        {
+            if (nodeClosures[node] == 255)
+                return false;
+            activeEntries += (nodeClosures[node]++ == 0);
+        }
+        else
+        {
+            if (nodeClosures[node] == 0)
+                return false;
+            activeEntries -= (--nodeClosures[node] == 0);
+        }
+        return true;
+    }
+
+    void clearEdge(int edgeId)
+    {
+        addSlowdown(edgeId, -extraPercent[edgeId]);
+    }
+
+    bool isNodeClosed(int node) const
+    {
+        return nodeClosures[node] != 0;
+    }
+
+    int getExtraPercent(int edgeId) const
+    {
+        return extraPercent[edgeId];
+    }
+
+    // Weight of an edge with its slowdown applied; weights at or above SEARCH_UNREACHABLE stay as they are
+    int weigh(int edgeId, int weight) const
+    {
+        if (extraPercent[edgeId] == 0 || weight >= SEARCH_UNREACHABLE)
+        {
+            return weight;
+        }
+        return (int)((long long)weight * (100 + extraPercent[edgeId]) / 100);
+    }
+};
+
+// Router edge filter policies: allows(edgeId, from, to) skips edges, weigh(edgeId, weight) adjusts their cost
+// PASSES_ALL lets the router use the vector kernel on the raw weights
+
+struct NoFilter
+{
+    static const bool PASSES_ALL = true;
+    bool allows(int, int, int) const { return true; }
+    int weigh(int, int weight) const { return weight; }
+};
+
+// Skips edges whose bit for the target's region is unset
+struct ArcFlagFilter
+{
+    static const bool PASSES_ALL = false;
+    const unsigned long long *flags;
+    unsigned long long regionBit;
+    bool allows(int edgeId, int, int) const { return (flags[edgeId] & regionBit) != 0; }
+    int weigh(int, int weight) const { return weight; }
+};
+
+// Skips edges marked closed in a bitset keyed by edge ID
+struct ClosureFilter
+{
+    static const bool PASSES_ALL = false;
+    const Bitset *closed;
+    bool allows(int edgeId, int, int) const { return !closed->atomicTest(edgeId); }
+    int weigh(int, int weight) const { return weight; }
+};
+
+// Applies a WeightOverlay on top of another filter
+template <typename Inner>
+struct OverlayFilter
+{
+    static const bool PASSES_ALL = false;
+    Inner inner;
+    const WeightOverlay *overlay;
+    bool allows(int edgeId, int from, int to) const
+    {
+        return !overlay->isNodeClosed(from) && !overlay->isNodeClosed(to) && inner.allows(edgeId, from, to);
+    }
+    int weigh(int edgeId, int weight) const { return overlay->weigh(edgeId, inner.weigh(edgeId, weight)); }
+};
+
+// Router heuristic policies: estimate(node) is a lower bound on the remaining distance
+// CONSISTENT promises a settled node is never improved again, which the vector kernel relies on
+
+struct ZeroHeuristic
+{
+    static const bool CONSISTENT = true;
+    int estimate(int) const { return 0; }
+};
+
+// Per-node estimates from a table; nothing guarantees the table is consistent
+struct TableHeuristic
+{
+    static const bool CONSISTENT = false;
+    const int *values;
+    int estimate(int node) const { return values[node]; }
+};
+
+// Per-thread scratch space for Router searches, allocated once and reused by every query
+// Slots are reset lazily: a slot whose stamp is not the current generation counts as untouched,
+// so starting a query is O(1) and a query only pays for the nodes it actually reaches
+template <typename Queue>
+class SearchWorkspace
+{
+private:
+    int capacity;
+    int queueCapacity;
+    int *dist;
+    int *parent;
+    int *parentEdge;
+    unsigned int *stamp;          // Generation that last wrote dist/parent of a slot
+    unsigned int *settledStamp;   // Generation in which a slot was settled
+    unsigned int generation;
+    Queue *queue;
+
+    void allocate(int nodes, int queueSize)
+    {
+        delete[] dist;
+        delete[] parent;
+        delete[] parentEdge;
+        delete[] stamp;
+        delete[] settledStamp;
+        delete queue;
+
+        capacity = nodes;
+        queueCapacity = queueSize;
+        dist = new int[capacity];
+        parent = new int[capacity];
+        parentEdge = new int[capacity];
+        stamp = new unsigned int[capacity];
+        settledStamp = new unsigned int[capacity];
+        for (int i = 0; i < capacity; i++)
+        {
+            stamp[i] = 0;
+            settledStamp[i] = 0;
+        }
+        generation = 0;
+        queue = new Queue(queueCapacity);
+    }
+
+public:
+    SearchWorkspace()
+        : capacity(0), queueCapacity(0), dist(nullptr), parent(nullptr), parentEdge(nullptr),
+          stamp(nullptr), settledStamp(nullptr), generation(0), queue(nullptr) {}
+
+    ~SearchWorkspace()
+    {
+        delete[] dist;
+        delete[] parent;
+        delete[] parentEdge;
+        delete[] stamp;
+        delete[] settledStamp;
+        delete queue;
+    }
+
+    // The workspace of the calling thread
+    static SearchWorkspace &local()
+    {
+        thread_local SearchWorkspace workspace;
+        return workspace;
+    }
+
+    // Start a new query; only grows (and clears) the arrays when the graph outgrew them
+    void begin(int nodeCount, int edgeCount)
+    {
+        if (nodeCount > capacity || edgeCount + nodeCount > queueCapacity)
+        {
+            allocate(nodeCount > capacity ? nodeCount * 2 : capacity,
+                     edgeCount + nodeCount > queueCapacity ? (edgeCount + nodeCount) * 2 : queueCapacity);
+        }
+
+        generation++;
+        if (generation == 0)
+        {
+            // Stamps wrapped around: clear them once every 2^32 queries
+            for (int i = 0; i < capacity; i++)
+            {
+                stamp[i] = 0;
+                settledStamp[i] = 0;
+            }
+            generation = 1;
+        }
+        queue->clear();
+    }
+
+    // Make a slot current, resetting it if an earlier query left it behind
+    void touch(int node)
+    {
+        if (stamp[node] != generation)
+        {
+            stamp[node] = generation;
+            dist[node] = SEARCH_UNREACHABLE;
+            parent[node] = -1;
+            parentEdge[node] = -1;
+        }
+    }
+
+    void update(int node, int distance, int from, int edgeId)
+    {
+        stamp[node] = generation;
+        dist[node] = distance;
+        parent[node] = from;
+        parentEdge[node] = edgeId;
+    }
+
+    int distance(int node) const
+    {
+        return stamp[node] == generation ? dist[node] : SEARCH_UNREACHABLE;
+    }
+
+    int getParent(int node) const
+    {
+        return stamp[node] == generation ? parent[node] : -1;
+    }
+
+    int getParentEdge(int node) const
+    {
+        return stamp[node] == generation ? parentEdge[node] : -1;
+    }
+
+    bool isSettled(int node) const
+    {
+        return settledStamp[node] == generation;
+    }
+
+    void settle(int node)
+    {
+        settledStamp[node] = generation;
+    }
+
+    // Raw distance array for the relaxation kernel; only touched slots are meaningful
+    int *distances()
+    {
+        return dist;
+    }
+
+    Queue &getQueue()
+    {
+        return *queue;
+    }
+
+    // Copy the whole search tree out, for callers that want every node
+    void copyTree(int nodeCount, int distOut[], int parentOut[], int parentEdgeOut[]) const
+    {
+        for (int i = 0; i < nodeCount; i++)
+        {
+            distOut[i] = distance(i);
+            parentOut[i] = getParent(i);
+            parentEdgeOut[i] = getParentEdge(i);
+        }
+    }
+};
+
+// Dijkstra / A* over a SearchGraph, with every policy fixed at compile time
+// Weights of SEARCH_UNREACHABLE or more never improve a distance, so closed edges can carry that weight
+// Results stay in the calling thread's SearchWorkspace until its next query
+template <typename Weight, typename Queue, typename EdgeFilter, typename Heuristic>
+class Router
+{
+private:
+    SearchGraph<Weight> graph;
+    EdgeFilter filter;
+    Heuristic heuristic;
+    SearchWorkspace<Queue> &workspace;
+
+public:
+    Router(const SearchGraph<Weight> &graph, const EdgeFilter &filter, const Heuristic &heuristic)
+        : graph(graph), filter(filter), heuristic(heuristic), workspace(SearchWorkspace<Queue>::local()) {}
+
+    SearchWorkspace<Queue> &getWorkspace()
+    {
+        return workspace;
+    }
+
+    // Search from all sources at once; stops when target (if >= 0) is settled
+    // Returns the distance to target; the tree is read back through the workspace
+    int search(const int sources[], int sourceCount, int target)
+    {
+        int improved[SIMD_MIN_DEGREE * 64];
+
+        workspace.begin(graph.nodeCount, graph.offset[graph.nodeCount]);
+        Queue &queue = workspace.getQueue();
+        for (int i = 0; i < sourceCount; i++)
+        {
+            workspace.update(sources[i], 0, -1, -1);
+            queue.push(sources[i], heuristic.estimate(sources[i]));
+        }
+
+        while (!queue.empty())
+        {
+            int key;
+            int u = queue.popMin(key);
+            if (workspace.isSettled(u))
+                continue;
+            workspace.settle(u);
+            if (u == target)
+                break;
+
+            int begin = graph.offset[u];
+            int degree = graph.offset[u + 1] - begin;
+            int distU = workspace.distance(u);
+
+            // The kernel cannot skip settled targets, so it is only safe when none can improve
+            if constexpr (EdgeFilter::PASSES_ALL && Heuristic::CONSISTENT && is_same<Weight, int>::value)
+            {
+                if (degree >= SIMD_MIN_DEGREE && degree <= SIMD_MIN_DEGREE * 64)
+                {
+                    // The kernel reads the raw array, so bring every target slot up to date first
+                    for (int e = begin; e < begin + degree; e++)
+                        workspace.touch(graph.target[e]);
+
+                    int *dist = workspace.distances();
+                    int count = relaxEdges(distU, graph.target + begin, (const int *)graph.weight + begin, degree, dist, improved);
+                    for (int k = 0; k < count; k++)
+                    {
+                        int e = begin + improved[k];
+                        int v = graph.target[e];
+                        workspace.update(v, dist[v], u, graph.edgeId[e]);
+                        queue.push(v, dist[v] + heuristic.estimate(v));
+                    }
+                    continue;
+                }
+            }
+
+            for (int e = begin; e < begin + degree; e++)
+            {
+                int v = graph.target[e];
+                if (!filter.allows(graph.edgeId[e], u, v) || workspace.isSettled(v))
+                    continue;
+
+                int newDist = distU + filter.weigh(graph.edgeId[e], (int)graph.weight[e]);
+                if (newDist < workspace.distance(v))
+                {
+                    workspace.update(v, newDist, u, graph.edgeId[e]);
+                    queue.push(v, newDist + heuristic.estimate(v));
+                }
+            }
+        }
+
+        return target >= 0 ? workspace.distance(target) : 0;
+    }
+};
+
+// Append-only journal of edits to a CSV snapshot
+// Every edit is one line appended to <name>.journal, fsync'd in batches. Loading applies the
+// snapshot, then a journal caught in the middle of compaction (<name>.journal.old), then the live
+// journal. Compaction rewrites the snapshot on a background thread. Records must be safe to apply
+// twice, so a crash between writing the snapshot and dropping the old journal loses nothing.
+class EditJournal
+{
+private:
+    static const int SYNC_BATCH = 16;
+    static const int COMPACT_THRESHOLD = 256;
+
+    string snapshotPath, journalPath, rotatedPath;
+    int fd = -1;
+    int unsynced = 0;
+    int records = 0;
+    thread compactor;
+
+    static bool writeAll(int out, const string &data)
+    {
+        size_t written = 0;
+        while (written < data.length())
+        {
+            ssize_t n = write(out, data.data() + written, data.length() - written);
+            if (n <= 0)
+            {
+                return false;
+            }
+            written += n;
+        }
+        return true;
+    }
+
+    // Runs on the compactor thread: replace the snapshot, then drop the journal it absorbed
+    static void writeSnapshot(string snapshotPath, string rotatedPath, string contents)
+    {
+        string tempPath = snapshotPath + ".tmp";
+        int out = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        bool ok = out != -1 && writeAll(out, contents) && fsync(out) == 0;
+        if (out != -1)
+        {
+            close(out);
+        }
+
+        if (!ok || rename(tempPath.c_str(), snapshotPath.c_str()) != 0)
+        {
+            cerr << "Error: Unable to compact " << snapshotPath << "; edits stay in the journal." << endl;
+            remove(tempPath.c_str());
+            return;
+        }
+        remove(rotatedPath.c_str());
+    }
+
+public:
+    // road_network.csv -> road_network.journal
+    static string journalFor(const string &snapshotPath)
+    {
+        string base = snapshotPath;
+        if (base.length() > 4 && base.compare(base.length() - 4, 4, ".csv") == 0)
+        {
+            base.erase(base.length() - 4);
+        }
+        return base + ".journal";
+    }
+
+    // Walks the records of both journals in order, skipping a torn last line
+    class Reader
+    {
+    private:
+        string paths[2];
+        int stage = -1;
+        ifstream file;
+
+    public:
+        int count = 0;
+        long journalBytes = 0;  // Length of the complete records in the live journal
+
+        Reader(const string &snapshotPath)
+        {
+            paths[1] = journalFor(snapshotPath);
+            paths[0] = paths[1] + ".old";
+        }
+
+        bool next(string &record)
+        {
+            while (stage < 2)
+            {
+                if (file.is_open() && getline(file, record) && !file.eof())
+                {
+                    if (stage == 1)
+                        journalBytes += record.length() + 1;
+                    if (!record.empty() && record.back() == '\r')
+                        record.pop_back();
+                    count++;
+                    return true;
+                }
+
+                file.close();
+                file.clear();
+                if (++stage < 2)
+                {
+                    file.open(paths[stage]);
+                }
+            }
+            return false;
+        }
+    };
+
+    ~EditJournal()
+    {
+        if (compactor.joinable())
+        {
+            compactor.join();
+        }
+        if (fd != -1)
+        {
+            sync();
+            close(fd);
+        }
+    }
+
+    // Start appending to the journal of a snapshot; reader must have replayed it to the end
+    void open(const string &snapshot, const Reader &reader)
+    {
+        snapshotPath = snapshot;
+        journalPath = journalFor(snapshot);
+        rotatedPath = journalPath + ".old";
+
+        // Cut a torn last record so the next append starts on a fresh line
+        if (truncate(journalPath.c_str(), reader.journalBytes) != 0 && errno != ENOENT)
+        {
+            cerr << "Error: Unable to repair " << journalPath << endl;
+        }
+
+        fd = ::open(journalPath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd == -1)
+        {
+            cerr << "Error: Unable to open " << journalPath << " for writing." << endl;
+        }
+        records = reader.count;
+    }
+
+    bool append(const string &record)
+    {
+        if (fd == -1 || !writeAll(fd, record + "\n"))
+        {
+            cerr << "Error: Unable to write to " << journalPath << endl;
+            return false;
+        }
+        records++;
+        if (++unsynced >= SYNC_BATCH)
+        {
+            sync();
+        }
+        return true;
+    }
+
+    void sync()
+    {
+        if (fd != -1 && unsynced > 0)
+        {
+            fsync(fd);
+            unsynced = 0;
+        }
+    }
+
+    bool needsCompaction() const
+    {
+        return records >= COMPACT_THRESHOLD;
+    }
+
+    // Hand the current state to the compactor thread and start an empty journal
+    void compact(const string &contents)
+    {
+        if (fd == -1)
+        {
+            return;
+        }
+        if (compactor.joinable())
+        {
+            compactor.join();
+        }
+        sync();
+        close(fd);
+
+        // A journal left over by an interrupted compaction must keep its records, so append to it
+        if (access(rotatedPath.c_str(), F_OK) == 0)
+        {
+            ifstream pending(journalPath, ios::binary);
+            stringstream data;
+            data << pending.rdbuf();
+            int out = ::open(rotatedPath.c_str(), O_WRONLY | O_APPEND);
+            if (out == -1 || !writeAll(out, data.str()) || fsync(out) != 0)
+            {
+                cerr << "Error: Unable to rotate " << journalPath << endl;
+                if (out != -1)
+                    close(out);
+                fd = ::open(journalPath.c_str(), O_WRONLY | O_APPEND);
+                return;
+            }
+            close(out);
+        }
+        else if (rename(journalPath.c_str(), rotatedPath.c_str()) != 0)
+        {
+            cerr << "Error: Unable to rotate " << journalPath << endl;
+            fd = ::open(journalPath.c_str(), O_WRONLY | O_APPEND);
+            return;
+        }
+
+        fd = ::open(journalPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+        records = 0;
+        compactor = thread(writeSnapshot, snapshotPath, rotatedPath, contents);
+    }
+};
+
+// Tells whether any of a few files changed since the last check
+// Uses inotify on their directories, so a check is a non-blocking read of queued events and touches
+// no files. Where inotify is unavailable it falls back to comparing modification times and sizes.
+class FileWatcher
+{
+private:
+    static const int MAX_FILES = 4;
+
+    string paths[MAX_FILES];
+    string names[MAX_FILES];
+    struct stat seen[MAX_FILES];
+    bool exists[MAX_FILES];
+    int count = 0;
+    int inotifyFd = -1;
+
+    bool statChanged(int i)
+    {
+        struct stat now;
+        bool found = stat(paths[i].c_str(), &now) == 0;
+        bool changed = found != exists[i] ||
+                       (found && (now.st_size != seen[i].st_size || now.st_ino != seen[i].st_ino ||
+                                  now.st_mtim.tv_sec != seen[i].st_mtim.tv_sec ||
+                                  now.st_mtim.tv_nsec != seen[i].st_mtim.tv_nsec));
+        exists[i] = found;
+        if (found)
+        {
+            seen[i] = now;
+        }
+        return changed;
+    }
+
+public:
+    FileWatcher()
+    {
+#ifdef __linux__
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+    }
+
+    ~FileWatcher()
+    {
+        if (inotifyFd != -1)
+        {
+            close(inotifyFd);
+        }
+    }
+
+    void watch(const string &path)
+    {
+        if (count == MAX_FILES)
+        {
+            return;
+        }
+
+        size_t slash = path.rfind('/');
+        string directory = (slash == string::npos) ? "." : path.substr(0, slash + 1);
+        paths[count] = path;
+        names[count] = (slash == string::npos) ? path : path.substr(slash + 1);
+        exists[count] = false;
+        statChanged(count);
+        count++;
+
+#ifdef __linux__
+        // Watch the directory: snapshots are replaced by rename, which a watch on the file would miss
+        if (inotifyFd != -1 &&
+            inotify_add_watch(inotifyFd, directory.c_str(),
+                              IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO) == -1)
+        {
+            close(inotifyFd);
+            inotifyFd = -1;
+        }
+#endif
+    }
+
+    // True if a watched file was written, replaced or removed since the last call
+    bool changed()
+    {
+        bool result = false;
+        if (inotifyFd == -1)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                if (statChanged(i))
+                    result = true;
+            }
+            return result;
+        }
+
+#ifdef __linux__
+        alignas(struct inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+        {
+            for (char *at = buffer; at < buffer + length;)
+            {
+                struct inotify_event *event = (struct inotify_event *)at;
+                for (int i = 0; i < count; ++i)
+                {
+                    if ((event->mask & IN_Q_OVERFLOW) || (event->len > 0 && names[i] == event->name))
+                        result = true;
+                }
+                at += sizeof(struct inotify_event) + event->len;
+            }
+        }
+#endif
+        return result;
+    }
+};
+
+// representing the roads bw intersections as egdes
+// travel time is weights
+
+// next pointer:used to point to the next edge in adjacency list
+// id: stable edge ID, used to index per-edge data and to encode routes
 class Edge
 {
 public:
-    char destination;
-    int weight;
-    Edge *next;
+    char destination;
+    int weight;
+    Edge *next;
+    int id;
+};
+
+// intersections are nodes
+// has a pointer to 1st edge which originates from here
+class Node
+{
+public:
+    char name;
+    Edge *head;
+};
+
+class Graph
+{
+public:
+    Node *nodes;
+    int size;
+    static const int INF = 10000;  // Use a large number as infinity
+    static const int UNREACHABLE = SEARCH_UNREACHABLE;  // Distance of intersections no route reaches
+    static const int MAX_EDGES = 1024;  // Maximum number of directed edges (edge IDs)
+
+    Bitset closedEdges;  // Closed roads, one bit per edge ID
+    unsigned char closureHolds[MAX_EDGES];  // Closures currently holding each edge closed
+    EditJournal roadJournal;  // Road edits since road_network.csv was last written
+
+    // Closures listed in the closure file and its journal, reloaded only when they change
+    string closureFile;
+    FileWatcher closureWatcher;
+    Bitset listedClosures;
+    unsigned int closureFileHash = 0;
+    bool closuresStale = true;  // Roads were added or removed since the list was applied
+
+    Edge *edgeTable[MAX_EDGES];  // Edge ID -> edge
+    char edgeSource[MAX_EDGES];  // Edge ID -> source intersection
+    int freeEdgeIds[MAX_EDGES];  // Recycled IDs of removed edges
+    int freeEdgeCount = 0;
+    int nextEdgeId = 0;
+    int epoch = 0;  // Bumped whenever roads or closures change, so cached routes can be invalidated
+    int rerouteEpoch = 0;  // Bumped when a road is added, removed or reopened; closures alone never shorten a route
+    int adjacencyEpoch = 0;  // Bumped by changes to roads and closures, the ones the contiguous copy below holds
+
+    // Slowdowns and intersection closures, applied during searches (they bump epoch, not adjacencyEpoch)
+    static_assert(WeightOverlay::MAX_EDGES == MAX_EDGES, "overlay must cover every edge ID");
+    WeightOverlay overlay;
+
+    // Components of the open roads, kept up to date by the changes below and rebuilt lazily
+    mutable ConnectivityIndex connectivity;
+
+    // Contiguous (CSR) copy of the adjacency lists for the search loops, rebuilt when the epoch changes
+    // Closed roads get BLOCKED_WEIGHT so relaxation skips them without a separate check
+    static const int BLOCKED_WEIGHT = UNREACHABLE;
+    mutable int csrOffset[101];
+    mutable int csrTarget[MAX_EDGES];
+    mutable int csrWeight[MAX_EDGES];
+    mutable int csrEdge[MAX_EDGES];
+    mutable int csrEpoch = -1;
+
+    int allocateEdgeId()
+    {
+        if (freeEdgeCount > 0)
+        {
+            return freeEdgeIds[--freeEdgeCount];
+        }
+        if (nextEdgeId < MAX_EDGES)
+        {
+            return nextEdgeId++;
+        }
+        return -1;
+    }
+
+    Node *findOrCreateNode(char name)
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            if (nodes[i].name == name)
+            {
+                return &nodes[i];
+            }
+            if (nodes[i].name == '\0')
+            {
+                nodes[i].name = name;
+                return &nodes[i];
+            }
+        }
+        return nullptr;
+    }
+
+    int parseInt(const char *str, int &index)
+    {
+        int result = 0;
+        while (str[index] >= '0' && str[index] <= '9')
+        {
+            result = result * 10 + (str[index] - '0');
+            index++;
+        }
+        return result;
+    }
+
+    Edge *sortEdges(Edge *head)
+    {
+        if (!head || !head->next)
+        {
+            return head;
+        }
+        // Bubble sort
+        for (Edge *current = head; current; current = current->next)
+        {
+            for (Edge *nextEdge = head; nextEdge->next; nextEdge = nextEdge->next)
+            {
+                if (nextEdge->destination > nextEdge->next->destination)
+                {
+                    char tempDestination = nextEdge->destination;
+                    nextEdge->destination = nextEdge->next->destination;
+                    nextEdge->next->destination = tempDestination;
+
+                    int tempWeight = nextEdge->weight;
+                    nextEdge->weight = nextEdge->next->weight;
+                    nextEdge->next->weight = tempWeight;
+
+                    int tempId = nextEdge->id;
+                    nextEdge->id = nextEdge->next->id;
+                    nextEdge->next->id = tempId;
+                    edgeTable[nextEdge->id] = nextEdge;
+                    edgeTable[nextEdge->next->id] = nextEdge->next;
+                }
+            }
+        }
+        return head;
+    }
+
+    Graph(int size)
+    {
+        this->size = size;
+        nodes = new Node[size];
+        for (int i = 0; i < size; ++i)
+        {
+            nodes[i].name = '\0';
+            nodes[i].head = nullptr;
+        }
+        for (int i = 0; i < MAX_EDGES; ++i)
+        {
+            edgeTable[i] = nullptr;
+            closureHolds[i] = 0;
+        }
+    }
+
+    ~Graph()
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            Edge *current = nodes[i].head;
+            while (current)
+            {
+                Edge *temp = current;
+                current = current->next;
+                delete temp;
+            }
+        }
+        delete[] nodes;
+    }
+
+    // Returns whether the edge was inserted (false for a duplicate or a full edge table)
+    bool addEdge(char source, char destination, int weight)
+    {
+        Node *sourceNode = findOrCreateNode(source);
+
+        Edge *current = sourceNode->head;
+        while (current)
+        {
+            if (current->destination == destination && current->weight == weight)
+            {
+                return false;
+                // inorder to avoid duplicate edges
+            }
+            current = current->next;
+        }
+
+        int id = allocateEdgeId();
+        if (id == -1)
+        {
+            cout << "Error: Maximum number of roads reached.\n";
+            return false;
+        }
+
+        Edge *newEdge = new Edge{destination, weight, sourceNode->head, id};
+        sourceNode->head = newEdge;
+        edgeTable[id] = newEdge;
+        edgeSource[id] = source;
+        if (travelCost(id) != -1)
+        {
+            connectivity.edgeAdded(id, source - 'A', destination - 'A');
+        }
+        epoch++;
+        rerouteEpoch++;
+        adjacencyEpoch++;
+        closuresStale = true;  // The closure list may name this road
+        return true;
+    }
+
+    // Remove the first edge to destination, or only the one with the given weight
+    bool removeEdge(char source, char destination, int weight = -1)
+    {
+        Node *sourceNode = findOrCreateNode(source);
+        Edge *current = sourceNode->head;
+        Edge *prev = nullptr;
+
+        while (current)
+        {
+            if (current->destination == destination && (weight == -1 || current->weight == weight))
+            {
+                if (prev)
+                    prev->next = current->next;
+                else
+                    sourceNode->head = current->next;
+
+                edgeTable[current->id] = nullptr;
+                closedEdges.atomicReset(current->id);  // A recycled ID must not inherit the closure
+                listedClosures.reset(current->id);
+                closureHolds[current->id] = 0;
+                overlay.clearEdge(current->id);
+                connectivity.edgeRemoved(current->id);
+                freeEdgeIds[freeEdgeCount++] = current->id;
+                epoch++;
+                rerouteEpoch++;
+                adjacencyEpoch++;
+                closuresStale = true;
+                delete current;
+                return true;
+            }
+            prev = current;
+            current = current->next;
+        }
+        return false;
+    }
+
+    void loadFromCSV(const char *filePath)
+    {
+        ifstream file(filePath);
+        if (!file.is_open())
+        {
+            cout << "Error: Could not open file " << filePath << endl;
+            return;
+        }
+
+        string line;
+        getline(file, line); 
+
+        while (getline(file, line))
+        {
+            int index = 0;
+            char source = line[index];
+            index += 2; // Skipping the comma
+            char destination = line[index];
+            index += 2;
+            int travelTime = 0;
+
+            while (index < line.size() && line[index] >= '0' && line[index] <= '9')
+            {
+                travelTime = travelTime * 10 + (line[index] - '0');
+                index++;
+            }
+
+            addEdge(source, destination, travelTime);
+            addEdge(destination, source, travelTime);
+        }
+
+        file.close();
+
+        // Roads added and removed since the file was last rewritten
+        EditJournal::Reader reader(filePath);
+        while (reader.next(line))
+        {
+            applyRoadRecord(line);
+        }
+        roadJournal.open(filePath, reader);
+    }
+
+    // Journal records: "+,A,B,weight" adds a road, "-,A,B,weight" removes it
+    void applyRoadRecord(const string &record)
+    {
+        if (record.length() < 7 || record[1] != ',' || record[3] != ',' || record[5] != ',')
+        {
+            return;
+        }
+
+        char source = record[2];
+        char destination = record[4];
+        int weight = atoi(record.c_str() + 6);
+        if (!isIntersection(source) || !isIntersection(destination))
+        {
+            return;
+        }
+
+        if (record[0] == '+')
+        {
+            addEdge(source, destination, weight);
+            addEdge(destination, source, weight);
+        }
+        else if (record[0] == '-')
+        {
+            removeEdge(source, destination, weight);
+            removeEdge(destination, source, weight);
+        }
+    }
+
+    // Append an edit to the journal; road_network.csv is only rewritten when the journal grows long
+    void journalRoadEdit(char op, char source, char destination, int weight)
+    {
+        string record = string(1, op) + "," + source + "," + destination + "," + to_string(weight);
+        if (roadJournal.append(record) && roadJournal.needsCompaction())
+        {
+            roadJournal.compact(snapshotCSV());
+        }
+    }
+
+    // The road network in road_network.csv format
+    string snapshotCSV() const
+    {
+        stringstream file;
+        file << "Source,Destination,TravelTime\n"; 
+
+        for (int i = 0; i < size; ++i)
+        {
+            if (nodes[i].name == '\0')
+                continue;
+
+            Edge *current = nodes[i].head;
+            while (current)
+            {
+                if (nodes[i].name < current->destination) 
+                {
+                    file << nodes[i].name << "," << current->destination << "," << current->weight << "\n";
+                }
+                current = current->next;
+            }
+        }
+
+        return file.str();
+    }
+
+    void displayGraph()
+    {
+        cout << "----- City Traffic Network -----\n";
+        for (int i = 0; i < size; ++i)
+        {
+            if (nodes[i].name == '\0')
+            {
+                continue;
+            }
+           
+            nodes[i].head = sortEdges(nodes[i].head);
+
+            cout << nodes[i].name << " -> ";
+            Edge *current = nodes[i].head;
+
+            while (current)
+            {
+                cout << "(" << current->destination << ", " << current->weight << ")";
+                if (current->next)
+                {
+                    cout << " ";
+                }
+                current = current->next;
+            }
+            cout << endl;
+        }
+    }
+
+    void addRoad()
+    {
+        char source, destination;
+        int weight;
+
+        cout << "Enter source intersection: ";
+        cin >> source;
+        cout << "Enter destination intersection: ";
+        cin >> destination;
+        cout << "Enter travel time (weight): ";
+        cin >> weight;
+
+        if (weight <= 0)
+        {
+            cout << "Error: Weight must be a positive integer.\n";
+            return;
+        }
+
+        bool forward = addEdge(source, destination, weight);
+        bool backward = addEdge(destination, source, weight);
+        if (!forward || !backward)
+        {
+            // Take back a half-added road so both directions stay in step
+            if (forward)
+                removeEdge(source, destination, weight);
+            if (backward)
+                removeEdge(destination, source, weight);
+            cout << "Road not added: it already exists or the road table is full.\n";
+            return;
+        }
+        journalRoadEdit('+', source, destination, weight);
+        cout << "Road added successfully.\n";
+    }
+
+    void removeRoad()
+    {
+        char source, destination;
+        cout << "Enter source intersection: ";
+        cin >> source;
+        cout << "Enter destination intersection: ";
+        cin >> destination;
+
+        int id = isIntersection(source) ? findEdgeId(source, destination) : -1;
+        int weight = (id == -1) ? -1 : getEdge(id)->weight;
+        if (id != -1 && removeEdge(source, destination, weight) && removeEdge(destination, source, weight))
+        {
+            journalRoadEdit('-', source, destination, weight);
+            cout << "Road removed successfully.\n";
+        }
+        else
+        {
+            cout << "Error: Road not found.\n";
+        }
+    }
+
+    void changeRoadSpeed(bool slowDown)
+    {
+        char source, destination;
+        int percent;
+        cout << "Enter source intersection: ";
+        cin >> source;
+        cout << "Enter destination intersection: ";
+        cin >> destination;
+        cout << "Enter extra travel time in percent: ";
+        cin >> percent;
+
+        if (percent <= 0)
+        {
+            cout << "Error: Percentage must be a positive integer.\n";
+            return;
+        }
+
+        if (slowRoad(source, destination, slowDown ? percent : -percent))
+            cout << "Road " << source << " - " << destination << " now takes "
+                 << 100 + overlay.getExtraPercent(findEdgeId(source, destination)) << "% of its normal travel time.\n";
+        else
+            cout << "Error: Road not found or slowdown out of range.\n";
+    }
+
+    void changeIntersection(bool close)
+    {
+        char name;
+        cout << "Enter intersection: ";
+        cin >> name;
+
+        if (setIntersectionClosed(name, close))
+            cout << "Intersection " << name << (close ? " closed.\n" : " reopened.\n");
+        else
+            cout << "Error: Unknown intersection or it is not closed.\n";
+    }
+
+    void manageRoads()
+    {
+        int choice;
+        do
+        {
+            cout << "\n1. Add a road\n";
+            cout << "2. Remove a road\n";
+            cout << "3. Slow down a road (lane closure)\n";
+            cout << "4. Lift a road slowdown\n";
+            cout << "5. Close an intersection\n";
+            cout << "6. Reopen an intersection\n";
+            cout << "7. Return to main menu\n";
+            cout << "Enter your choice: ";
+            cin >> choice;
+
+            if (choice == 1)
+                addRoad();
+            else if (choice == 2)
+                removeRoad();
+            else if (choice == 3 || choice == 4)
+                changeRoadSpeed(choice == 3);
+            else if (choice == 5 || choice == 6)
+                changeIntersection(choice == 5);
+            else if (choice != 7)
+                cout << "Invalid choice. Try again.\n";
+
+        } while (choice != 7);
+    }
+
+    // Load blocked roads from a CSV file and its journal
+    // Only the difference to the previously loaded list is applied, so rows removed from the file reopen roads
+    void loadBlockedRoads(const char* filePath) 
+    {
+        ifstream file(filePath);
+        if (!file.is_open()) 
+        {
+            cout << "Error: Could not open blocked roads file " << filePath << endl;
+            return;
+        }
+
+        Bitset listed;
+        unsigned int hash = 2166136261u;  // FNV-1a over the rows, to skip lists that did not really change
+        string line;
+        getline(file, line); // Skip the header line
+
+        while (getline(file, line)) 
+        {
+            hash = hashClosureRecord(hash, line);
+            applyClosureRecord(line, listed);
+        }
+
+        file.close();
+
+        // Closures recorded since the file was last rewritten
+        EditJournal::Reader reader(filePath);
+        while (reader.next(line))
+        {
+            hash = hashClosureRecord(hash, line);
+            applyClosureRecord(line, listed);
+        }
+
+        if (hash == closureFileHash && !closuresStale)
+        {
+            return;
+        }
+        closureFileHash = hash;
+        closuresStale = false;
+
+        bool changed = false;
+        for (int id = 0; id < MAX_EDGES; ++id)
+        {
+            if (listed.test(id) != listedClosures.test(id))
+            {
+                changed |= holdEdge(id, listed.test(id));
+            }
+        }
+        listedClosures = listed;
+
+        if (changed)
+        {
+            epoch++;
+            adjacencyEpoch++;
+        }
+    }
+
+    // Load the closure list and keep watching it for changes
+    void watchBlockedRoads(const char* filePath)
+    {
+        closureFile = filePath;
+        string journal = EditJournal::journalFor(filePath);
+        closureWatcher.watch(filePath);
+        closureWatcher.watch(journal);
+        closureWatcher.watch(journal + ".old");
+        loadBlockedRoads(filePath);
+    }
+
+    // Reload the closure list if its files changed; otherwise touches no files
+    void refreshBlockedRoads()
+    {
+        if (!closureFile.empty() && (closureWatcher.changed() || closuresStale))
+        {
+            loadBlockedRoads(closureFile.c_str());
+        }
+    }
+
+    static unsigned int hashClosureRecord(unsigned int hash, const string &line)
+    {
+        for (char c : line)
+        {
+            hash ^= (unsigned char)c;
+            hash *= 16777619u;
+        }
+        hash ^= '\n';
+        return hash * 16777619u;
+    }
+
+    // Add one road_closures.csv row (or journal record) of Intersection1,Intersection2,Status to a closure list
+    void applyClosureRecord(const string &line, Bitset &listed) const
+    {
+        // Use stringstream to parse the CSV line
+        stringstream ss(line);
+        string intersection1, intersection2, status;
+
+        // Extract the values separated by commas
+        getline(ss, intersection1, ','); // First intersection
+        getline(ss, intersection2, ','); // Second intersection
+        getline(ss, status, ',');        // Status of the road
+
+        // Manual trimming of leading whitespace
+        int start = 0;
+        while (start < status.length() && (status[start] == ' ' || status[start] == '\t')) 
+        {
+            start++;
+        }
+
+        // Manual trimming of trailing whitespace
+        int end = status.length() - 1;
+        while (end >= start && (status[end] == ' ' || status[end] == '\t')) 
+        {
+            end--;
+        }
+
+        // Extract the cleaned status string
+        string trimmedStatus = status.substr(start, end - start + 1);
+
+        // Only consider roads that are "Blocked"
+        if (trimmedStatus == "Blocked" && !intersection1.empty() && !intersection2.empty()) 
+        {
+            char start = intersection1[0], end = intersection2[0];
+            if (isIntersection(start) && isIntersection(end))
+            {
+                int ids[2] = {findEdgeId(start, end), findEdgeId(end, start)};
+                for (int i = 0; i < 2; ++i)
+                {
+                    if (ids[i] != -1)
+                        listed.set(ids[i]);
+                }
+            }
+        }
+    }
+
+    bool isIntersection(char name) const
+    {
+        return name >= 'A' && name - 'A' < size && name - 'A' < 100;
+    }
+
+    // Add or release one closure of an edge; it stays closed while any closure holds it
+    // Returns whether the edge opened or closed
+    bool holdEdge(int id, bool closed)
+    {
+        if (closed)
+        {
+            if (closureHolds[id] < 255 && closureHolds[id]++ == 0)
+            {
+                closedEdges.atomicSet(id);
+                connectivity.edgeRemoved(id);
+                return true;
+            }
+        }
+        else if (closureHolds[id] > 0 && --closureHolds[id] == 0)
+        {
+            closedEdges.atomicReset(id);
+            if (travelCost(id) != -1)
+            {
+                connectivity.edgeAdded(id, edgeSource[id] - 'A', edgeTable[id]->destination - 'A');
+            }
+            rerouteEpoch++;
+            return true;
+        }
+        return false;
+    }
+
+    // Close or release a closure of a road in both directions; the epoch only moves if something changed
+    // Closures from different sources (the closure file, scheduled roadworks) stack
+    bool setRoadClosed(char start, char end, bool closed)
+    {
+        if (!isIntersection(start) || !isIntersection(end))
+        {
+            return false;
+        }
+
+        bool changed = false;
+        int ids[2] = {findEdgeId(start, end), findEdgeId(end, start)};
+        for (int i = 0; i < 2; ++i)
+        {
+            if (ids[i] != -1 && holdEdge(ids[i], closed))
+            {
+                changed = true;
+            }
+        }
+
+        if (changed)
+        {
+            epoch++;
+            adjacencyEpoch++;
+        }
+        return changed;
+    }
+
+    bool closeRoad(char start, char end)
+    {
+        return setRoadClosed(start, end, true);
+    }
+
+    bool openRoad(char start, char end)
+    {
+        return setRoadClosed(start, end, false);
+    }
+
+    bool isEdgeClosed(int id) const
+    {
+        return closedEdges.atomicTest(id);
+    }
+
+    // Travel time of an edge with the overlay applied; -1 if the road or an intersection at either end is closed
+    int travelCost(int id) const
+    {
+        const Edge *edge = getEdge(id);
+        if (edge == nullptr || isEdgeClosed(id) || overlay.isNodeClosed(edge->destination - 'A') ||
+            overlay.isNodeClosed(edgeSource[id] - 'A'))
+        {
+            return -1;
+        }
+        return overlay.weigh(id, edge->weight);
+    }
+
+    // Slow a road down by a percentage in both directions (lane closure, roadworks); a negative
+    // percentage lifts an earlier slowdown. Slowdowns on the same road add up.
+    bool slowRoad(char start, char end, int percent)
+    {
+        if (!isIntersection(start) || !isIntersection(end))
+        {
+            return false;
+        }
+
+        int ids[2] = {findEdgeId(start, end), findEdgeId(end, start)};
+        if (ids[0] == -1 || ids[1] == -1)
+        {
+            return false;
+        }
+        if (!overlay.addSlowdown(ids[0], percent))
+        {
+            return false;
+        }
+        if (!overlay.addSlowdown(ids[1], percent))
+        {
+            overlay.addSlowdown(ids[0], -percent);
+            return false;
+        }
+        epoch++;
+        rerouteEpoch++;
+        return true;
+    }
+
+    // Close (or reopen) an intersection: no route may enter or leave it until the last closure is lifted
+    bool setIntersectionClosed(char name, bool closed)
+    {
+        if (!isIntersection(name) || name - 'A' >= WeightOverlay::MAX_NODES || !overlay.setNodeClosed(name - 'A', closed))
+        {
+            return false;
+        }
+        connectivity.markStale();
+        epoch++;
+        rerouteEpoch++;
+        return true;
+    }
+
+    // Function to check if a road is blocked
+    bool isRoadBlocked(char start, char end) const
+    {
+        if (!isIntersection(start) || !isIntersection(end))
+        {
+            return false;
+        }
+        int id = findEdgeId(start, end);
+        return id != -1 && isEdgeClosed(id);
+    }
+
+    // Rebuild the contiguous adjacency if the graph changed
+    // Searches call this themselves; call it before sharing the graph between threads
+    void refreshAdjacency() const
+    {
+        if (csrEpoch == adjacencyEpoch)
+        {
+            return;
+        }
+
+        int position = 0;
+        for (int i = 0; i < size && i < 100; ++i)
+        {
+            csrOffset[i] = position;
+            for (Edge *edge = nodes[i].head; edge != nullptr; edge = edge->next)
+            {
+                csrTarget[position] = edge->destination - 'A';
+                csrWeight[position] = isEdgeClosed(edge->id) ? BLOCKED_WEIGHT : edge->weight;
+                csrEdge[position] = edge->id;
+                position++;
+            }
+        }
+        csrOffset[size < 100 ? size : 100] = position;
+        csrEpoch = adjacencyEpoch;
+    }
+
+    // Rebuild the components if a change since the last build could have split one
+    void refreshConnectivity() const
+    {
+        if (!connectivity.isStale())
+        {
+            return;
+        }
+
+        connectivity.reset(size < 100 ? size : 100);
+        for (int u = 0; u < size && u < 100; ++u)
+        {
+            for (Edge *edge = nodes[u].head; edge != nullptr; edge = edge->next)
+            {
+                if (travelCost(edge->id) != -1)
+                {
+                    connectivity.edgeAdded(edge->id, u, edge->destination - 'A');
+                }
+            }
+        }
+    }
+
+    // False if no route can join the two intersections, answered without a search
+    bool mayReach(char source, char destination) const
+    {
+        if (!isIntersection(source) || !isIntersection(destination) || source - 'A' >= 100 || destination - 'A' >= 100)
+        {
+            return true;  // Left to the search
+        }
+        refreshConnectivity();
+        return connectivity.connected(source - 'A', destination - 'A');
+    }
+
+    const Edge *getEdge(int id) const
+    {
+        return (id >= 0 && id < MAX_EDGES) ? edgeTable[id] : nullptr;
+    }
+
+    char getEdgeSource(int id) const
+    {
+        return edgeSource[id];
+    }
+
+    // Run a search from source, stopping at target if given; the tree is left in this thread's workspace
+    // With arc flags, edges whose bit for the target's region is unset are skipped
+    int search(char source, char target, const unsigned long long *arcFlags = nullptr, unsigned long long regionBit = 0) const
+    {
+        refreshAdjacency();
+
+        SearchGraph<int> view = {size < 100 ? size : 100, csrOffset, csrTarget, csrEdge, csrWeight};
+        int sources[1] = {source - 'A'};
+        int targetIndex = (target == '\0') ? -1 : target - 'A';
+
+        // Closed roads carry BLOCKED_WEIGHT, so the unfiltered router needs no closure check
+        // The overlay is only layered in while it holds something, keeping the vector kernel otherwise
+        if (arcFlags != nullptr && !overlay.isEmpty())
+        {
+            OverlayFilter<ArcFlagFilter> filter = {ArcFlagFilter{arcFlags, regionBit}, &overlay};
+            Router<int, BinaryHeapQueue, OverlayFilter<ArcFlagFilter>, ZeroHeuristic> router(view, filter, ZeroHeuristic());
+            return router.search(sources, 1, targetIndex);
+        }
+        if (arcFlags != nullptr) 
+        {
+            Router<int, BinaryHeapQueue, ArcFlagFilter, ZeroHeuristic> router(view, ArcFlagFilter{arcFlags, regionBit}, ZeroHeuristic());
+            return router.search(sources, 1, targetIndex);
+        }
+        if (!overlay.isEmpty())
+        {
+            OverlayFilter<NoFilter> filter = {NoFilter(), &overlay};
+            Router<int, BinaryHeapQueue, OverlayFilter<NoFilter>, ZeroHeuristic> router(view, filter, ZeroHeuristic());
+            return router.search(sources, 1, targetIndex);
+        }
+
+        Router<int, BinaryHeapQueue, NoFilter, ZeroHeuristic> router(view, NoFilter(), ZeroHeuristic());
+        return router.search(sources, 1, targetIndex);
+    }
+
+    // Shortest path tree from source: dist, previous intersection and the edge ID used to reach each node
+    void shortestPathTree(char source, int dist[], char prev[], int prevEdge[],
+                          const unsigned long long *arcFlags = nullptr, unsigned long long regionBit = 0, char target = '\0') const
+    {
+        search(source, target, arcFlags, regionBit);
+
+        const SearchWorkspace<BinaryHeapQueue> &workspace = SearchWorkspace<BinaryHeapQueue>::local();
+        int nodeCount = size < 100 ? size : 100;
+        for (int i = 0; i < nodeCount; ++i) 
+        {
+            int parent = workspace.getParent(i);
+            dist[i] = workspace.distance(i);
+            prev[i] = (parent == -1) ? '\0' : (char)(parent + 'A');
+            prevEdge[i] = workspace.getParentEdge(i);
+        }
+    }
+
+    // Edge IDs of the shortest route from source to destination; returns the edge count or -1 if unreachable
+    int shortestPathEdges(char source, char destination, int edgeIds[], int maxEdges) const
+    {
+        if (!mayReach(source, destination) || search(source, destination) == UNREACHABLE)
+        {
+            return -1;
+        }
+
+        const SearchWorkspace<BinaryHeapQueue> &workspace = SearchWorkspace<BinaryHeapQueue>::local();
+        int count = 0;
+        for (int at = destination - 'A'; workspace.getParentEdge(at) != -1 && count < maxEdges; at = workspace.getParent(at))
+        {
+            edgeIds[count++] = workspace.getParentEdge(at);
+        }
+
+        // Collected backwards, flip into travel order
+        for (int i = 0; i < count / 2; ++i)
+        {
+            int temp = edgeIds[i];
+            edgeIds[i] = edgeIds[count - 1 - i];
+            edgeIds[count - 1 - i] = temp;
+        }
+        return count;
+    }
+
+    // Edge ID of the road from -> to, or -1
+    int findEdgeId(char from, char to) const
+    {
+        for (Edge *edge = nodes[from - 'A'].head; edge != nullptr; edge = edge->next)
+        {
+            if (edge->destination == to)
+            {
+                return edge->id;
+            }
+        }
+        return -1;
+    }
+
+    // Alternative routes with the plateau method
+    // One tree from the source and one towards the destination are searched once; every via node v
+    // then yields the route source -> v -> destination. Candidates on long plateaus (stretches where both
+    // trees agree) are preferred, and a route is kept only if it is near-optimal and differs enough
+    // from the routes already chosen. Returns the number of routes written.
+    int alternativeRoutes(char source, char destination, int routes[][100], int routeLengths[], int routeCosts[], int maxRoutes) const
+    {
+        const double MAX_STRETCH = 1.4;  // Alternatives may be at most 40% slower than the best route
+        const double MAX_OVERLAP = 0.7;  // ...and share at most 70% of their travel time with another route
+
+        int fwdDist[100], bwdDist[100];
+        char fwdPrev[100], bwdPrev[100];
+        int fwdEdge[100], bwdEdge[100];
+
+        // Roads are stored in both directions, so the tree from the destination is the reverse search tree
+        shortestPathTree(source, fwdDist, fwdPrev, fwdEdge);
+        shortestPathTree(destination, bwdDist, bwdPrev, bwdEdge);
+
+        int best = fwdDist[destination - 'A'];
+        if (best == UNREACHABLE || maxRoutes < 1)
+        {
+            return 0;
+        }
+
+        // Plateau length through every node: how far both trees agree around it
+        int plateau[100];
+        int candidates[100];
+        int candidateCount = 0;
+        for (int v = 0; v < size; ++v)
+        {
+            plateau[v] = 0;
+            if (fwdDist[v] == UNREACHABLE || bwdDist[v] == UNREACHABLE || fwdDist[v] + bwdDist[v] > best * MAX_STRETCH)
+            {
+                continue;
+            }
+
+            for (int x = v; fwdPrev[x] != '\0' && bwdPrev[fwdPrev[x] - 'A'] - 'A' == x; x = fwdPrev[x] - 'A')
+            {
+                plateau[v] += fwdDist[x] - fwdDist[fwdPrev[x] - 'A'];
+            }
+            for (int x = v; bwdPrev[x] != '\0' && fwdPrev[bwdPrev[x] - 'A'] - 'A' == x; x = bwdPrev[x] - 'A')
+            {
+                plateau[v] += bwdDist[x] - bwdDist[bwdPrev[x] - 'A'];
+            }
+            candidates[candidateCount++] = v;
+        }
+
+        // Longest plateau first, cheaper route breaking ties
+        for (int i = 1; i < candidateCount; ++i)
+        {
+            int v = candidates[i];
+            int j = i - 1;
+            while (j >= 0 && (plateau[candidates[j]] < plateau[v] ||
+                   (plateau[candidates[j]] == plateau[v] && fwdDist[candidates[j]] + bwdDist[candidates[j]] > fwdDist[v] + bwdDist[v])))
+            {
+                candidates[j + 1] = candidates[j];
+                j--;
+            }
+            candidates[j + 1] = v;
+        }
+
+        // The best route is read straight off the forward tree, the same one best was measured on
+        int bestLength = 0;
+        for (int x = destination - 'A'; fwdPrev[x] != '\0'; x = fwdPrev[x] - 'A')
+        {
+            routes[0][bestLength++] = fwdEdge[x];
+        }
+        for (int i = 0; i < bestLength / 2; ++i)
+        {
+            int temp = routes[0][i];
+            routes[0][i] = routes[0][bestLength - 1 - i];
+            routes[0][bestLength - 1 - i] = temp;
+        }
+        routeLengths[0] = bestLength;
+        routeCosts[0] = best;
+        int routeCount = 1;
+
+        for (int c = 0; c < candidateCount && routeCount < maxRoutes; ++c)
+        {
+            int v = candidates[c];
+            int path[100];
+            int length = 0;
+            bool seen[100] = {false};
+            bool simple = true;
+
+            // source -> v, collected backwards along the forward tree
+            for (int x = v; fwdPrev[x] != '\0'; x = fwdPrev[x] - 'A')
+            {
+                path[length++] = fwdEdge[x];
+            }
+            for (int i = 0; i < length / 2; ++i)
+            {
+                int temp = path[i];
+                path[i] = path[length - 1 - i];
+                path[length - 1 - i] = temp;
+            }
+
+            // v -> destination, following the backward tree and flipping each edge
+            for (int x = v; bwdPrev[x] != '\0' && length < 100; x = bwdPrev[x] - 'A')
+            {
+                path[length++] = findEdgeId(x + 'A', bwdPrev[x]);
+            }
+
+            seen[source - 'A'] = true;
+            for (int i = 0; i < length && simple; ++i)
+            {
+                if (path[i] == -1)
+                {
+                    simple = false;  // One-way road with no way back
+                    break;
+                }
+                char next = edgeTable[path[i]]->destination;
+                simple = !seen[next - 'A'];
+                seen[next - 'A'] = true;
+            }
+            if (!simple)
+            {
+                continue;
+            }
+
+            int cost = fwdDist[v] + bwdDist[v];
+            bool distinct = true;
+            for (int r = 0; r < routeCount && distinct; ++r)
+            {
+                int shared = 0;
+                for (int i = 0; i < length; ++i)
+                {
+                    for (int j = 0; j < routeLengths[r]; ++j)
+                    {
+                        if (path[i] == routes[r][j])
+                        {
+                            shared += travelCost(path[i]);
+                            break;
+                        }
+                    }
+                }
+                distinct = shared <= cost * MAX_OVERLAP;
+            }
+            if (!distinct)
+            {
+                continue;
+            }
+
+            for (int i = 0; i < length; ++i)
+            {
+                routes[routeCount][i] = path[i];
+            }
+            routeLengths[routeCount] = length;
+            routeCosts[routeCount] = cost;
+            routeCount++;
+        }
+
+        return routeCount;
+    }
+
+    // Print a few alternative routes so congested traffic can be spread over them
+    void showAlternativeRoutes(char source, char destination, int maxRoutes) const
+    {
+        int routes[5][100];
+        int routeLengths[5];
+        int routeCosts[5];
+
+        if (maxRoutes > 5)
+            maxRoutes = 5;
+
+        int count = alternativeRoutes(source, destination, routes, routeLengths, routeCosts, maxRoutes);
+        if (count == 0)
+        {
+            cout << "No route found from " << source << " to " << destination << endl;
+            return;
+        }
+
+        for (int r = 0; r < count; ++r)
+        {
+            cout << "Route " << r + 1 << ": " << source;
+            for (int i = 0; i < routeLengths[r]; ++i)
+            {
+                cout << " -> " << edgeTable[routes[r][i]]->destination;
+            }
+            cout << " | Travel time: " << routeCosts[r] << endl;
+        }
+    }
+
+    // Isochrone: intersections and road segments reachable from any origin within the travel time budget
+    // A road segment counts only if it can be driven end to end inside the budget
+    void isochrone(const char origins[], int originCount, int budget, Bitset &reachedNodes, Bitset &reachedEdges) const
+    {
+        int dist[100];
+        bool visited[100] = {false};
+
+        for (int i = 0; i < size; ++i)
+        {
+            dist[i] = UNREACHABLE;
+        }
+
+        reachedNodes.clear();
+        reachedEdges.clear();
+
+        PriorityQueue pq(MAX_EDGES + size);
+        for (int i = 0; i < originCount; ++i)
+        {
+            if (origins[i] < 'A' || origins[i] > 'Z' || !isIntersection(origins[i]))
+            {
+                continue;  // Unknown origins reach nothing
+            }
+            dist[origins[i] - 'A'] = 0;
+            pq.insert(origins[i], 0);
+        }
+
+        while (!pq.isEmpty())
+        {
+            char current = pq.extractMin().vertex;
+            if (visited[current - 'A'])
+            {
+                continue;
+            }
+
+            visited[current - 'A'] = true;
+            reachedNodes.set(current - 'A');
+
+            for (Edge *edge = nodes[current - 'A'].head; edge != nullptr; edge = edge->next)
+            {
+                int cost = travelCost(edge->id);
+                if (cost == -1)
+                {
+                    continue;
+                }
+
+                int newDist = dist[current - 'A'] + cost;
+                if (newDist > budget)
+                {
+                    continue;  // Beyond the budget, never expanded
+                }
+
+                reachedEdges.set(edge->id);
+                if (newDist < dist[edge->destination - 'A'])
+                {
+                    dist[edge->destination - 'A'] = newDist;
+                    pq.insert(edge->destination, newDist);
+                }
+            }
+        }
+    }
+
+    // Print the service area of a set of origins, and what every origin covers if there are several
+    void serviceArea()
+    {
+        int originCount, budget;
+        char origins[26];
+
+        cout << "Enter number of origins: ";
+        cin >> originCount;
+        if (originCount < 1 || originCount > 26)
+        {
+            cout << "Error: Number of origins must be between 1 and 26.\n";
+            return;
+        }
+        cout << "Enter origin intersections: ";
+        for (int i = 0; i < originCount; ++i)
+        {
+            cin >> origins[i];
+            if (origins[i] < 'A' || origins[i] > 'Z' || !isIntersection(origins[i]))
+            {
+                cout << "Error: Invalid intersection " << origins[i] << ".\n";
+                return;
+            }
+        }
+        cout << "Enter travel time budget: ";
+        cin >> budget;
+
+        Bitset covered, coveredByAll, roads, single, singleRoads;
+        for (int i = 0; i < originCount; ++i)
+        {
+            isochrone(&origins[i], 1, budget, single, singleRoads);
+            if (i == 0)
+                coveredByAll = single;
+            else
+                coveredByAll.intersectWith(single);
+            covered.unionWith(single);
+            roads.unionWith(singleRoads);
+        }
+
+        cout << "Intersections reachable within " << budget << ": ";
+        for (int i = 0; i < size; ++i)
+        {
+            if (covered.test(i))
+                cout << (char)(i + 'A') << " ";
+        }
+        cout << "\nRoad segments covered: " << roads.count() << endl;
+
+        if (originCount > 1)
+        {
+            cout << "Reachable from every origin: ";
+            for (int i = 0; i < size; ++i)
+            {
+                if (coveredByAll.test(i))
+                    cout << (char)(i + 'A') << " ";
+            }
+            cout << endl;
+        }
+    }
+
+    void dijkstra(char source, char destination, bool vehicle,
+                  const unsigned long long *arcFlags = nullptr, unsigned long long regionBit = 0) const
+    {
+        // Intersections in different components are rejected before searching the whole graph
+        if (!mayReach(source, destination))
+        {
+            cout << "No route found from " << source << " to " << destination << endl;
+            return;
+        }
+
+        // Only the nodes the search reached are touched; the tree stays in the workspace
+        int distance = search(source, destination, arcFlags, regionBit);
+        const SearchWorkspace<BinaryHeapQueue> &workspace = SearchWorkspace<BinaryHeapQueue>::local();
+
+        // Check if a valid path exists
+        if (distance == UNREACHABLE) 
+        {
+            cout << "No route found from " << source << " to " << destination << endl;
+            return;  // No route found, exit the function
+        }
+
+        if (!vehicle)
+        {
+            // If a valid path exists, print the path
+            cout << "Path from " << source << " to " << destination << ": ";
+        }
+
+        // To trace the path, we start from destination and move backwards using the parents
+        char path[100];
+        int pathIndex = 0;
+
+        for (int at = destination - 'A'; at != -1; at = workspace.getParent(at)) 
+        {
+            path[pathIndex++] = at + 'A';
+        }
+
+        // Print path in reverse order with arrows
+        for (int i = pathIndex - 1; i >= 0; --i) 
+        {
+            cout << path[i];
+            if (i > 0) 
+            {
+                cout << " -> ";
+            }
+        }
+
+        cout << "\nTotal distance: " << distance << endl;
+    }
+
+    void dfs(char current, char end, char currentPath[], int &currentIndex,
+            char paths[][100], int pathWeights[], int &pathCount, int currentWeight,
+            bool visited[]) 
+    {
+        visited[current - 'A'] = true;
+        currentPath[currentIndex++] = current;
+
+        if (current == end) 
+        {
+            // Save the path
+            if (pathCount < 100) 
+            {
+                for (int i = 0; i < currentIndex; ++i) 
+                {
+                    paths[pathCount][i] = currentPath[i];
+                }
+                paths[pathCount][currentIndex] = '\0'; // Null-terminate
+                pathWeights[pathCount] = currentWeight;
+                pathCount++;
+            }
+        } 
+        else 
+        {
+            // Visit all neighbors sorted by destination
+            Node *nodePtr = findOrCreateNode(current);
+            
+            // Sort edges by destination before traversing them
+            Edge* sortedHead = sortEdges(nodePtr->head);
+            
+            for (Edge *edge = sortedHead; edge != nullptr; edge = edge->next) 
+            {
+                if (!visited[edge->destination - 'A']) 
+                {
+                    dfs(edge->destination, end, currentPath, currentIndex, paths, pathWeights, pathCount, currentWeight + edge->weight, visited);
+                }
+            }
+        }
+
+        // Backtrack
+        visited[current - 'A'] = false;
+        currentIndex--;
+    }
+
+    void findAllPaths(char start, char end) 
+    {
+        const int MAX_PATHS = 100;  // Maximum number of paths to store
+        const int MAX_NODES = 100;  // Maximum nodes in a graph
+
+        char paths[MAX_PATHS][MAX_NODES];  // To store all paths
+        int pathWeights[MAX_PATHS];         // To store weights of each path
+        int pathCount = 0;                  // Number of paths found
+
+        bool visited[26] = {false};
+        char currentPath[100];
+        int currentIndex = 0;
+
+        dfs(start, end, currentPath, currentIndex, paths, pathWeights, pathCount, 0, visited);
+
+        // Display all paths and their weights
+        cout << "All possible paths from " << start << " to " << end << " are:\n";
+        for (int i = 0; i < pathCount; ++i) 
+        {
+            cout << "Path: ";
+            for (int j = 0; paths[i][j] != '\0'; ++j) 
+            {
+                cout << paths[i][j];
+                if (paths[i][j + 1] != '\0') 
+                {
+                    cout << " -> ";
+                }
+            }
+            cout << " | Total Weight: " << pathWeights[i] << endl;
+        }
+    }
+
+    
+};
+
+// Metric-independent partition of the intersections into cells
+// Cells are grown by BFS over the road topology only (no weights, no closures),
+// so they stay valid while travel times and closures change
+class GraphPartition
+{
+public:
+    static const int MAX_CELLS = 64;
+
+    int cellOf[100];  // Cell of each intersection (-1 for unused slots)
+    int cellCount = 0;
+
+    void build(const Graph &graph, int maxCellSize)
+    {
+        int queue[100];
+
+        for (int i = 0; i < graph.size; ++i)
+        {
+            cellOf[i] = -1;
+        }
+        cellCount = 0;
+
+        for (int seed = 0; seed < graph.size; ++seed)
+        {
+            if (graph.nodes[seed].name == '\0' || cellOf[seed] != -1)
+            {
+                continue;
+            }
+
+            // Grow a new cell around the seed; leftovers join the last cell once MAX_CELLS is reached
+            int cell = (cellCount < MAX_CELLS) ? cellCount++ : MAX_CELLS - 1;
+            int front = 0, rear = 0, members = 0;
+            cellOf[seed] = cell;
+            queue[rear++] = seed;
+            members++;
+
+            while (front != rear && members < maxCellSize)
+            {
+                int u = queue[front++];
+                for (Edge *edge = graph.nodes[u].head; edge != nullptr && members < maxCellSize; edge = edge->next)
+                {
+                    int v = edge->destination - 'A';
+                    if (cellOf[v] == -1)
+                    {
+                        cellOf[v] = cell;
+                        queue[rear++] = v;
+                        members++;
+                    }
+                }
+            }
+        }
+    }
+
+    bool covers(const Graph &graph) const
+    {
+        for (int i = 0; i < graph.size; ++i)
+        {
+            if (graph.nodes[i].name != '\0' && cellOf[i] == -1)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Customizable Route Planning style overlay on top of a GraphPartition
+// Every cell keeps a clique of shortcuts between its boundary intersections. When roads or closures
+// change, only the cells containing changed edges are re-customized. Queries search the original
+// roads inside the source and target cells and jump across every other cell via its clique.
+// A single overlay level is enough for networks of a few hundred intersections.
+class OverlayRouter
+{
+private:
+    static const int CELL_SIZE = 6;
+    static const int MAX_BOUNDARY = 24;
+    static const int NO_COST = -1;
+
+    GraphPartition partition;
+    int boundary[GraphPartition::MAX_CELLS][MAX_BOUNDARY];      // Boundary intersections of each cell
+    int boundaryCount[GraphPartition::MAX_CELLS];
+    int boundaryIndex[100];                                     // Position in its cell's boundary list (-1 if interior)
+    int clique[GraphPartition::MAX_CELLS][MAX_BOUNDARY][MAX_BOUNDARY];
+    bool cellDirty[GraphPartition::MAX_CELLS];
+
+    int edgeCost[Graph::MAX_EDGES];  // Snapshot of the weights the overlay was customized with
+    int edgeFrom[Graph::MAX_EDGES];  // and of the ends of each edge ID (-1 if unused), as IDs are recycled
+    int edgeTo[Graph::MAX_EDGES];
+    bool built = false;
+    int seenEpoch = -1;
+
+    int effectiveCost(const Graph &graph, int id) const
+    {
+        int cost = graph.travelCost(id);
+        return (cost == -1) ? NO_COST : cost;
+    }
+
+    void snapshotEdge(const Graph &graph, int id)
+    {
+        const Edge *edge = graph.getEdge(id);
+        edgeCost[id] = effectiveCost(graph, id);
+        edgeFrom[id] = edge != nullptr ? graph.getEdgeSource(id) - 'A' : -1;
+        edgeTo[id] = edge != nullptr ? edge->destination - 'A' : -1;
+    }
+
+    void findBoundaries(const Graph &graph)
+    {
+        for (int c = 0; c < partition.cellCount; ++c)
+        {
+            boundaryCount[c] = 0;
+        }
+
+        for (int u = 0; u < graph.size; ++u)
+        {
+            boundaryIndex[u] = -1;
+            if (graph.nodes[u].name == '\0')
+            {
+                continue;
+            }
+
+            int cell = partition.cellOf[u];
+            for (Edge *edge = graph.nodes[u].head; edge != nullptr; edge = edge->next)
+            {
+                if (partition.cellOf[edge->destination - 'A'] != cell && boundaryCount[cell] < MAX_BOUNDARY)
+                {
+                    boundaryIndex[u] = boundaryCount[cell];
+                    boundary[cell][boundaryCount[cell]++] = u;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Dijkstra restricted to one cell, using the snapshot costs
+    void cellSearch(const Graph &graph, int cell, int from, int dist[], int prevEdge[]) const
+    {
+        bool visited[100] = {false};
+        for (int i = 0; i < graph.size; ++i)
+        {
+            dist[i] = Graph::UNREACHABLE;
+            prevEdge[i] = -1;
+        }
+        dist[from] = 0;
+
+        PriorityQueue pq(Graph::MAX_EDGES + graph.size);
+        pq.insert(from + 'A', 0);
+        while (!pq.isEmpty())
+        {
+            int u = pq.extractMin().vertex - 'A';
+            if (visited[u])
+            {
+                continue;
+            }
+            visited[u] = true;
+
+            for (Edge *edge = graph.nodes[u].head; edge != nullptr; edge = edge->next)
+            {
+                int v = edge->destination - 'A';
+                if (partition.cellOf[v] != cell || edgeCost[edge->id] == NO_COST)
+                {
+                    continue;
+                }
+                if (dist[u] + edgeCost[edge->id] < dist[v])
+                {
+                    dist[v] = dist[u] + edgeCost[edge->id];
+                    prevEdge[v] = edge->id;
+                    pq.insert(edge->destination, dist[v]);
+                }
+            }
+        }
+    }
+
+    void customizeCell(const Graph &graph, int cell)
+    {
+        int dist[100], prevEdge[100];
+        for (int i = 0; i < boundaryCount[cell]; ++i)
+        {
+            cellSearch(graph, cell, boundary[cell][i], dist, prevEdge);
+            for (int j = 0; j < boundaryCount[cell]; ++j)
+            {
+                clique[cell][i][j] = dist[boundary[cell][j]];
+            }
+        }
+        cellDirty[cell] = false;
+    }
+
+public:
+    // Bring the overlay up to date with the graph; only cells with changed edges are recomputed
+    void refresh(const Graph &graph)
+    {
+        if (built && seenEpoch == graph.epoch)
+        {
+            return;
+        }
+
+        if (!built || !partition.covers(graph))
+        {
+            partition.build(graph, CELL_SIZE);
+            for (int id = 0; id < Graph::MAX_EDGES; ++id)
+            {
+                snapshotEdge(graph, id);
+            }
+            for (int c = 0; c < partition.cellCount; ++c)
+            {
+                cellDirty[c] = true;
+            }
+            built = true;
+        }
+        else
+        {
+            for (int id = 0; id < Graph::MAX_EDGES; ++id)
+            {
+                const Edge *edge = graph.getEdge(id);
+                int from = edge != nullptr ? graph.getEdgeSource(id) - 'A' : -1;
+                int to = edge != nullptr ? edge->destination - 'A' : -1;
+                if (effectiveCost(graph, id) == edgeCost[id] && from == edgeFrom[id] && to == edgeTo[id])
+                {
+                    continue;
+                }
+
+                // A recycled ID may now join other intersections: both the old and the new cells change
+                if (edgeFrom[id] != -1)
+                {
+                    cellDirty[partition.cellOf[edgeFrom[id]]] = true;
+                    cellDirty[partition.cellOf[edgeTo[id]]] = true;
+                }
+                if (from != -1)
+                {
+                    cellDirty[partition.cellOf[from]] = true;
+                    cellDirty[partition.cellOf[to]] = true;
+                }
+                snapshotEdge(graph, id);
+            }
+        }
+
+        findBoundaries(graph);
+        for (int c = 0; c < partition.cellCount; ++c)
+        {
+            if (cellDirty[c])
+            {
+                customizeCell(graph, c);
+            }
+        }
+        seenEpoch = graph.epoch;
+    }
+
+    // Shortest route as edge IDs over the overlay; returns the edge count or -1 if unreachable
+    int shortestPathEdges(const Graph &graph, char source, char destination, int edgeIds[], int &distance)
+    {
+        refresh(graph);
+
+        int s = source - 'A', t = destination - 'A';
+        int dist[100];
+        int prev[100];       // Previous intersection
+        int prevEdge[100];   // Edge used, or -1 when reached through a clique shortcut
+        bool visited[100] = {false};
+
+        for (int i = 0; i < graph.size; ++i)
+        {
+            dist[i] = Graph::UNREACHABLE;
+            prev[i] = -1;
+            prevEdge[i] = -1;
+        }
+        dist[s] = 0;
+
+        PriorityQueue pq(Graph::MAX_EDGES * 2 + graph.size);
+        pq.insert(source, 0);
+        while (!pq.isEmpty())
+        {
+            int u = pq.extractMin().vertex - 'A';
+            if (visited[u])
+            {
+                continue;
+            }
+            visited[u] = true;
+            if (u == t)
+            {
+                break;
+            }
+
+            int cell = partition.cellOf[u];
+            bool local = (cell == partition.cellOf[s] || cell == partition.cellOf[t]);
+
+            // Clique shortcuts inside a cell that is only crossed
+            if (!local && boundaryIndex[u] != -1)
+            {
+                int i = boundaryIndex[u];
+                for (int j = 0; j < boundaryCount[cell]; ++j)
+                {
+                    int v = boundary[cell][j];
+                    int cost = clique[cell][i][j];
+                    if (v == u || cost == Graph::UNREACHABLE || visited[v] || dist[u] + cost >= dist[v])
+                    {
+                        continue;
+                    }
+                    dist[v] = dist[u] + cost;
+                    prev[v] = u;
+                    prevEdge[v] = -1;
+                    pq.insert(v + 'A', dist[v]);
+                }
+            }
+
+            // Original roads: all of them in local cells, only cell-leaving ones elsewhere
+            for (Edge *edge = graph.nodes[u].head; edge != nullptr; edge = edge->next)
+            {
+                int v = edge->destination - 'A';
+                if (edgeCost[edge->id] == NO_COST || visited[v])
+                {
+                    continue;
+                }
+                if (!local && partition.cellOf[v] == cell)
+                {
+                    continue;
+                }
+                if (dist[u] + edgeCost[edge->id] < dist[v])
+                {
+                    dist[v] = dist[u] + edgeCost[edge->id];
+                    prev[v] = u;
+                    prevEdge[v] = edge->id;
+                    pq.insert(edge->destination, dist[v]);
+                }
+            }
+        }
+
+        if (dist[t] == Graph::UNREACHABLE)
+        {
+            return -1;
+        }
+        distance = dist[t];
+
+        // Walk back, unpacking each shortcut with a search inside its cell
+        int count = 0;
+        for (int v = t; v != s; v = prev[v])
+        {
+            if (prevEdge[v] != -1)
+            {
+                edgeIds[count++] = prevEdge[v];
+                continue;
+            }
+
+            int cellDist[100], cellPrev[100];
+            cellSearch(graph, partition.cellOf[v], prev[v], cellDist, cellPrev);
+            for (int x = v; x != prev[v]; x = graph.getEdgeSource(cellPrev[x]) - 'A')
+            {
+                edgeIds[count++] = cellPrev[x];
+            }
+        }
+
+        for (int i = 0; i < count / 2; ++i)
+        {
+            int temp = edgeIds[i];
+            edgeIds[i] = edgeIds[count - 1 - i];
+            edgeIds[count - 1 - i] = temp;
+        }
+        return count;
+    }
+
+    void route(const Graph &graph, char source, char destination)
+    {
+        int edgeIds[100];
+        int distance = 0;
+        int count = shortestPathEdges(graph, source, destination, edgeIds, distance);
+        if (count == -1)
+        {
+            cout << "No route found from " << source << " to " << destination << endl;
+            return;
+        }
+
+        cout << "Path from " << source << " to " << destination << ": " << source;
+        for (int i = 0; i < count; ++i)
+        {
+            cout << " -> " << graph.getEdge(edgeIds[i])->destination;
+        }
+        cout << "\nTotal distance: " << distance << endl;
+    }
 };
 
-// intersections are nodes
-// has a pointer to 1st edge which originates from here
-class Node
+// Hub labeling distance oracle
+// Every intersection stores a forward label (hubs it can reach) and a backward label (hubs that reach it),
+// both sorted by hub rank, so a distance query is a merge of two sorted arrays. Labels are built from
+// all-pairs distances computed in parallel, pruned in rank order, and saved to disk for the next run.
+class HubLabels
 {
+private:
+    static const int MAX_LABEL = 100;
+
+    struct LabelEntry
+    {
+        int hub;       // Rank of the hub (labels are sorted by it)
+        int distance;
+    };
+
+    LabelEntry fwdLabel[100][MAX_LABEL];
+    LabelEntry bwdLabel[100][MAX_LABEL];
+    int fwdCount[100];
+    int bwdCount[100];
+    int rankOf[100];
+
+    int nodeCount = 0;
+    bool built = false;
+    int seenEpoch = -1;
+    unsigned int signature = 0;  // Network the labels were built for
+
+    // FNV-1a over every open road, so labels on disk can be matched to the network
+    unsigned int networkSignature(const Graph &graph) const
+    {
+        unsigned int hash = 2166136261u;
+        for (int u = 0; u < graph.size; ++u)
+        {
+            for (Edge *edge = graph.nodes[u].head; edge != nullptr; edge = edge->next)
+            {
+                int cost = graph.travelCost(edge->id);
+                if (cost == -1)
+                    continue;
+                unsigned int values[3] = {(unsigned int)u, (unsigned int)edge->destination, (unsigned int)cost};
+                for (int i = 0; i < 3; ++i)
+                {
+                    hash ^= values[i];
+                    hash *= 16777619u;
+                }
+            }
+        }
+        return hash;
+    }
+
+    static int merge(const LabelEntry *a, int aCount, const LabelEntry *b, int bCount)
+    {
+        int best = Graph::UNREACHABLE;
+        int i = 0, j = 0;
+        while (i < aCount && j < bCount)
+        {
+            if (a[i].hub < b[j].hub)
+                i++;
+            else if (a[i].hub > b[j].hub)
+                j++;
+            else
+            {
+                if (a[i].distance + b[j].distance < best)
+                    best = a[i].distance + b[j].distance;
+                i++;
+                j++;
+            }
+        }
+        return best;
+    }
+
+    void build(const Graph &graph)
+    {
+        nodeCount = graph.size;
+
+        // All-pairs distances, one shortest path tree per source, sources split across threads
+        graph.refreshAdjacency();
+        int (*table)[100] = new int[100][100];
+        int threadCount = thread::hardware_concurrency();
+        if (threadCount < 1)
+            threadCount = 1;
+        if (threadCount > 8)
+            threadCount = 8;
+
+        thread *workers = new thread[threadCount];
+        for (int t = 0; t < threadCount; ++t)
+        {
+            workers[t] = thread([&graph, table, t, threadCount]()
+            {
+                char prev[100];
+                int prevEdge[100];
+                for (int s = t; s < graph.size; s += threadCount)
+                {
+                    if (graph.nodes[s].name != '\0')
+                        graph.shortestPathTree(s + 'A', table[s], prev, prevEdge);
+                    else
+                        for (int i = 0; i < graph.size; ++i)
+                            table[s][i] = Graph::UNREACHABLE;
+                }
+            });
+        }
+        for (int t = 0; t < threadCount; ++t)
+        {
+            workers[t].join();
+        }
+        delete[] workers;
+
+        // Rank hubs by degree: busy intersections cover the most shortest paths
+        int order[100], degree[100];
+        for (int u = 0; u < graph.size; ++u)
+        {
+            degree[u] = 0;
+            for (Edge *edge = graph.nodes[u].head; edge != nullptr; edge = edge->next)
+                degree[u]++;
+            order[u] = u;
+            fwdCount[u] = 0;
+            bwdCount[u] = 0;
+        }
+        for (int i = 1; i < graph.size; ++i)
+        {
+            int v = order[i];
+            int j = i - 1;
+            while (j >= 0 && degree[order[j]] < degree[v])
+            {
+                order[j + 1] = order[j];
+                j--;
+            }
+            order[j + 1] = v;
+        }
+
+        // Pruned labeling: a hub is added only where the labels so far give a wrong distance
+        for (int r = 0; r < graph.size; ++r)
+        {
+            int v = order[r];
+            rankOf[v] = r;
+            if (graph.nodes[v].name == '\0')
+                continue;
+
+            for (int u = 0; u < graph.size; ++u)
+            {
+                int toU = table[v][u];
+                if (toU != Graph::UNREACHABLE && bwdCount[u] < MAX_LABEL &&
+                    merge(fwdLabel[v], fwdCount[v], bwdLabel[u], bwdCount[u]) > toU)
+                {
+                    bwdLabel[u][bwdCount[u]++] = {r, toU};
+                }
+
+                int fromU = table[u][v];
+                if (fromU != Graph::UNREACHABLE && fwdCount[u] < MAX_LABEL &&
+                    merge(fwdLabel[u], fwdCount[u], bwdLabel[v], bwdCount[v]) > fromU)
+                {
+                    fwdLabel[u][fwdCount[u]++] = {r, fromU};
+                }
+            }
+        }
+
+        delete[] table;
+        built = true;
+    }
+
+    void save(const char *filePath) const
+    {
+        ofstream file(filePath);
+        if (!file.is_open())
+        {
+            cout << "Error: Could not open file for saving hub labels.\n";
+            return;
+        }
+
+        file << signature << " " << nodeCount << "\n";
+        for (int u = 0; u < nodeCount; ++u)
+        {
+            file << fwdCount[u];
+            for (int i = 0; i < fwdCount[u]; ++i)
+                file << " " << fwdLabel[u][i].hub << " " << fwdLabel[u][i].distance;
+            file << "\n" << bwdCount[u];
+            for (int i = 0; i < bwdCount[u]; ++i)
+                file << " " << bwdLabel[u][i].hub << " " << bwdLabel[u][i].distance;
+            file << "\n";
+        }
+        file.close();
+    }
+
+    // Load labels saved for the same network; returns false if the file is missing or outdated
+    bool load(const char *filePath, unsigned int expected, int expectedNodes)
+    {
+        ifstream file(filePath);
+        if (!file.is_open())
+            return false;
+
+        unsigned int savedSignature;
+        int savedNodes;
+        if (!(file >> savedSignature >> savedNodes) || savedSignature != expected || savedNodes != expectedNodes)
+            return false;
+
+        for (int u = 0; u < savedNodes; ++u)
+        {
+            if (!(file >> fwdCount[u]) || fwdCount[u] < 0 || fwdCount[u] > MAX_LABEL)
+                return false;
+            for (int i = 0; i < fwdCount[u]; ++i)
+                file >> fwdLabel[u][i].hub >> fwdLabel[u][i].distance;
+            if (!(file >> bwdCount[u]) || bwdCount[u] < 0 || bwdCount[u] > MAX_LABEL)
+                return false;
+            for (int i = 0; i < bwdCount[u]; ++i)
+                file >> bwdLabel[u][i].hub >> bwdLabel[u][i].distance;
+        }
+
+        nodeCount = savedNodes;
+        built = !file.fail();
+        return built;
+    }
+
 public:
-    char name;
-    Edge *head;
+    // Make sure the labels match the current network, loading or rebuilding them as needed
+    void refresh(const Graph &graph, const char *filePath)
+    {
+        if (built && seenEpoch == graph.epoch)
+            return;
+
+        unsigned int current = networkSignature(graph);
+        if (!built || current != signature)
+        {
+            signature = current;
+            if (!load(filePath, current, graph.size))
+            {
+                build(graph);
+                save(filePath);
+            }
+        }
+        seenEpoch = graph.epoch;
+    }
+
+    // Distance between two intersections (Graph::UNREACHABLE if there is no route)
+    int distance(char source, char destination) const
+    {
+        int s = source - 'A', t = destination - 'A';
+        return merge(fwdLabel[s], fwdCount[s], bwdLabel[t], bwdCount[t]);
+    }
+
+    // Same output as Graph::dijkstra; the path is recovered hop by hop from label distances
+    void query(const Graph &graph, char source, char destination, bool vehicle)
+    {
+        refresh(graph, "hub_labels.dat");
+
+        int total = distance(source, destination);
+        if (total == Graph::UNREACHABLE)
+        {
+            cout << "No route found from " << source << " to " << destination << endl;
+            return;
+        }
+
+        if (!vehicle)
+        {
+            cout << "Path from " << source << " to " << destination << ": ";
+        }
+
+        cout << source;
+        for (char at = source; at != destination;)
+        {
+            int remaining = distance(at, destination);
+            char next = '\0';
+            for (Edge *edge = graph.nodes[at - 'A'].head; edge != nullptr; edge = edge->next)
+            {
+                int cost = graph.travelCost(edge->id);
+                if (cost != -1 && cost + distance(edge->destination, destination) == remaining)
+                {
+                    next = edge->destination;
+                    break;
+                }
+            }
+            if (next == '\0')
+                break;  // Labels out of sync with the graph
+            cout << " -> " << next;
+            at = next;
+        }
+
+        cout << "\nTotal distance: " << total << endl;
+    }
 };
 
-// Blocked road structure
-struct BlockedRoad 
+// Arc-flag accelerator
+// Intersections are grouped into regions; every edge keeps one bit per region saying whether it starts
+// a shortest path into that region. Searches towards a target then skip every edge without the bit of
+// the target's region. A closure only invalidates the regions whose flag the closed edge carried.
+class ArcFlags
 {
-    char intersection1;
-    char intersection2;
-    
-    // Check if two roads are blocked (either direction)
-    bool isBlocked(char start, char end) const 
+private:
+    static const int REGION_SIZE = 4;
+    static const int NO_COST = -1;
+
+    GraphPartition partition;
+    unsigned long long flags[Graph::MAX_EDGES];
+    int edgeCost[Graph::MAX_EDGES];  // Weights the flags were computed with
+    int edgeEnds[Graph::MAX_EDGES];  // from * 100 + to of each edge ID (-1 if unused), as IDs are recycled
+    unsigned long long dirtyRegions = 0;
+    bool built = false;
+    int seenEpoch = -1;
+
+    int effectiveCost(const Graph &graph, int id) const
+    {
+        int cost = graph.travelCost(id);
+        return (cost == -1) ? NO_COST : cost;
+    }
+
+    int ends(const Graph &graph, int id) const
+    {
+        const Edge *edge = graph.getEdge(id);
+        return edge != nullptr ? (graph.getEdgeSource(id) - 'A') * 100 + (edge->destination - 'A') : -1;
+    }
+
+    void computeRegion(const Graph &graph, int region)
+    {
+        unsigned long long bit = 1ULL << region;
+        for (int id = 0; id < Graph::MAX_EDGES; ++id)
+        {
+            flags[id] &= ~bit;
+        }
+
+        int dist[100];
+        char prev[100];
+        int prevEdge[100];
+        for (int b = 0; b < graph.size; ++b)
+        {
+            if (graph.nodes[b].name == '\0' || partition.cellOf[b] != region)
+            {
+                continue;
+            }
+
+            bool isBoundary = false;
+            for (Edge *edge = graph.nodes[b].head; edge != nullptr; edge = edge->next)
+            {
+                int v = edge->destination - 'A';
+                if (partition.cellOf[v] == region)
+                    flags[edge->id] |= bit;  // Roads inside the region are always allowed
+                else
+                    isBoundary = true;
+            }
+            if (!isBoundary)
+            {
+                continue;
+            }
+
+            // Roads run both ways, so the tree from b gives every distance towards b
+            graph.shortestPathTree(b + 'A', dist, prev, prevEdge);
+            for (int u = 0; u < graph.size; ++u)
+            {
+                if (dist[u] == Graph::UNREACHABLE)
+                    continue;
+                for (Edge *edge = graph.nodes[u].head; edge != nullptr; edge = edge->next)
+                {
+                    int v = edge->destination - 'A';
+                    if (edgeCost[edge->id] != NO_COST && dist[v] != Graph::UNREACHABLE &&
+                        dist[v] + edgeCost[edge->id] == dist[u])
+                    {
+                        flags[edge->id] |= bit;
+                    }
+                }
+            }
+        }
+    }
+
+public:
+    // Recompute the flags of regions affected by changes since the last refresh
+    void refresh(const Graph &graph)
+    {
+        if (built && seenEpoch == graph.epoch)
+        {
+            return;
+        }
+
+        if (!built || !partition.covers(graph))
+        {
+            partition.build(graph, REGION_SIZE);
+            for (int id = 0; id < Graph::MAX_EDGES; ++id)
+            {
+                edgeCost[id] = effectiveCost(graph, id);
+                edgeEnds[id] = ends(graph, id);
+                flags[id] = 0;
+            }
+            dirtyRegions = ~0ULL;
+            built = true;
+        }
+        else
+        {
+            for (int id = 0; id < Graph::MAX_EDGES; ++id)
+            {
+                int cost = effectiveCost(graph, id);
+                int edgeNow = ends(graph, id);
+                if (edgeNow != edgeEnds[id])
+                {
+                    // Road added, removed or its ID recycled: old flags are void and a new road can matter anywhere
+                    dirtyRegions = ~0ULL;
+                    flags[id] = 0;
+                    edgeCost[id] = cost;
+                    edgeEnds[id] = edgeNow;
+                    continue;
+                }
+                if (cost == edgeCost[id])
+                {
+                    continue;
+                }
+
+                // A slower or closed road only matters to regions it led to; a faster or new one can matter anywhere
+                bool worse = (cost == NO_COST) || (edgeCost[id] != NO_COST && cost > edgeCost[id]);
+                dirtyRegions |= worse ? flags[id] : ~0ULL;
+                edgeCost[id] = cost;
+                if (cost == NO_COST)
+                {
+                    flags[id] = 0;
+                }
+            }
+        }
+
+        for (int r = 0; r < partition.cellCount; ++r)
+        {
+            if (dirtyRegions & (1ULL << r))
+            {
+                computeRegion(graph, r);
+            }
+        }
+        dirtyRegions = 0;
+        seenEpoch = graph.epoch;
+    }
+
+    unsigned long long regionBit(char intersection) const
+    {
+        return 1ULL << partition.cellOf[intersection - 'A'];
+    }
+
+    const unsigned long long *getFlags() const
+    {
+        return flags;
+    }
+
+    void query(const Graph &graph, char source, char destination, bool vehicle)
     {
-        return (intersection1 == start && intersection2 == end) || 
-               (intersection1 == end && intersection2 == start);
+        refresh(graph);
+        graph.dijkstra(source, destination, vehicle, flags, regionBit(destination));
     }
 };
 
-class Graph
+// Critical roads: bridges (roads whose closure splits the network) and articulation intersections
+// Found with Tarjan's low-link DFS over the open roads, taken as undirected links between
+// intersection pairs. The DFS forest is kept between refreshes: a road opening inside one tree
+// covers the tree path between its ends, so the bridges on that path stop being bridges, and
+// closing a bridge just splits its subtree off. Other changes rerun the DFS.
+// Closing a bridge cuts off exactly the subtree below it, a preorder interval in the DFS forest.
+class CriticalRoads
 {
-public:
-    Node *nodes;
-    int size;
-    static const int INF = 10000;  // Use a large number as infinity
-    static const int MAX_BLOCKED_ROADS = 100;  // Maximum number of blocked roads
+private:
+    static const int MAX_NODES = 100;
+    static const int NONE = -1;
+
+    int linkFrom[Graph::MAX_EDGES];  // Ends of each open edge as of the last refresh (NONE if closed)
+    int linkTo[Graph::MAX_EDGES];
+    unsigned short linkCount[MAX_NODES * MAX_NODES];  // Open edges between each intersection pair
+    int touchedStamp[MAX_NODES * MAX_NODES];
+    int stamp = 0;
+
+    int parent[MAX_NODES];
+    int depth[MAX_NODES];
+    int treeRoot[MAX_NODES];
+    int preorder[MAX_NODES];
+    int subtreeSize[MAX_NODES];
+    int nodeAt[MAX_NODES];       // Preorder number -> node
+    bool bridgeAbove[MAX_NODES]; // The tree link from parent[v] to v is a bridge
+    bool articulation[MAX_NODES];
+    int nodeCount = 0;
+    bool built = false;
+    bool articulationStale = true;
+    int seenEpoch = -1;
+
+    int pairKey(int a, int b) const
+    {
+        return a < b ? a * MAX_NODES + b : b * MAX_NODES + a;
+    }
 
-    BlockedRoad blockedRoads[MAX_BLOCKED_ROADS];  // Array to store blocked roads
-    int blockedRoadCount = 0;  // Counter to keep track of how many roads are blocked
+    // Iterative Tarjan over the links of the last refresh
+    void rebuild(const Graph &graph)
+    {
+        // Undirected adjacency: every open edge is listed at both of its ends
+        int adjStart[MAX_NODES + 1] = {0};
+        int adjNode[2 * Graph::MAX_EDGES];
+        for (int id = 0; id < Graph::MAX_EDGES; ++id)
+        {
+            if (linkFrom[id] != NONE && linkFrom[id] != linkTo[id])
+            {
+                adjStart[linkFrom[id] + 1]++;
+                adjStart[linkTo[id] + 1]++;
+            }
+        }
+        for (int v = 0; v < nodeCount; ++v)
+        {
+            adjStart[v + 1] += adjStart[v];
+        }
+        int fill[MAX_NODES];
+        for (int v = 0; v < nodeCount; ++v)
+        {
+            fill[v] = adjStart[v];
+        }
+        for (int id = 0; id < Graph::MAX_EDGES; ++id)
+        {
+            if (linkFrom[id] != NONE && linkFrom[id] != linkTo[id])
+            {
+                adjNode[fill[linkFrom[id]]++] = linkTo[id];
+                adjNode[fill[linkTo[id]]++] = linkFrom[id];
+            }
+        }
 
-    Node *findOrCreateNode(char name)
+        int low[MAX_NODES];
+        int children[MAX_NODES];
+        int nextLink[MAX_NODES];
+        int stack[MAX_NODES];
+
+        for (int v = 0; v < nodeCount; ++v)
+        {
+            preorder[v] = NONE;
+            parent[v] = NONE;
+            bridgeAbove[v] = false;
+            articulation[v] = false;
+        }
+
+        int counter = 0;
+        for (int root = 0; root < nodeCount; ++root)
+        {
+            if (graph.nodes[root].name == '\0' || preorder[root] != NONE)
+            {
+                continue;
+            }
+
+            int top = 0;
+            stack[top++] = root;
+            depth[root] = 0;
+            treeRoot[root] = root;
+            preorder[root] = low[root] = counter;
+            nodeAt[counter++] = root;
+            children[root] = 0;
+            nextLink[root] = adjStart[root];
+
+            while (top > 0)
+            {
+                int u = stack[top - 1];
+                if (nextLink[u] < adjStart[u + 1])
+                {
+                    int v = adjNode[nextLink[u]++];
+                    if (v == parent[u])
+                    {
+                        continue;  // Every edge between the same two intersections is one road
+                    }
+                    if (preorder[v] == NONE)
+                    {
+                        parent[v] = u;
+                        depth[v] = depth[u] + 1;
+                        treeRoot[v] = root;
+                        preorder[v] = low[v] = counter;
+                        nodeAt[counter++] = v;
+                        children[v] = 0;
+                        nextLink[v] = adjStart[v];
+                        children[u]++;
+                        stack[top++] = v;
+                    }
+                    else if (preorder[v] < low[u])
+                    {
+                        low[u] = preorder[v];
+                    }
+                    continue;
+                }
+
+                // Every road of u is done
+                top--;
+                subtreeSize[u] = counter - preorder[u];
+                int p = parent[u];
+                if (p == NONE)
+                {
+                    articulation[u] = children[u] > 1;
+                    continue;
+                }
+                if (low[u] < low[p])
+                    low[p] = low[u];
+                if (low[u] > preorder[p])
+                    bridgeAbove[u] = true;
+                if (parent[p] != NONE && low[u] >= preorder[p])
+                    articulation[p] = true;
+            }
+        }
+        articulationStale = false;
+    }
+
+    // A road opened inside one tree: the tree path between its ends now lies on a cycle
+    void coverPath(int u, int v)
     {
-        for (int i = 0; i < size; ++i)
+        while (u != v)
         {
-            if (nodes[i].name == name)
+            if (depth[u] < depth[v])
             {
-                return &nodes[i];
+                int swap = u;
+                u = v;
+                v = swap;
             }
-            if (nodes[i].name == '\0')
+            bridgeAbove[u] = false;
+            u = parent[u];
+        }
+    }
+
+    // The bridge above child closed: its subtree becomes a tree of its own
+    // Preorder intervals are left as they are, so walks over them skip nodes of other trees
+    void splitBelow(int child)
+    {
+        int base = depth[child];
+        int root = treeRoot[child];
+        for (int i = preorder[child]; i < preorder[child] + subtreeSize[child]; ++i)
+        {
+            if (treeRoot[nodeAt[i]] == root)
             {
-                nodes[i].name = name;
-                return &nodes[i];
+                treeRoot[nodeAt[i]] = child;
+                depth[nodeAt[i]] -= base;
             }
         }
-        return nullptr;
+        bridgeAbove[child] = false;
+        parent[child] = NONE;
     }
 
-    int parseInt(const char *str, int &index)
+    // Nodes of v's subtree still in v's tree
+    int subtreeCount(int v) const
     {
-        int result = 0;
-        while (str[index] >= '0' && str[index] <= '9')
+        int count = 0;
+        for (int i = preorder[v]; i < preorder[v] + subtreeSize[v]; ++i)
         {
-            result = result * 10 + (str[index] - '0');
-            index++;
+            if (treeRoot[nodeAt[i]] == treeRoot[v])
+                count++;
         }
-        return result;
+        return count;
     }
 
-    Edge *sortEdges(Edge *head)
+    // Apply a road that appeared or disappeared between a and b; false if the DFS has to be rerun
+    bool applyLink(int a, int b, bool open)
     {
-        if (!head || !head->next)
+        if (preorder[a] == NONE || preorder[b] == NONE)
         {
-            return head;
+            return false;
         }
-        // Bubble sort
-        for (Edge *current = head; current; current = current->next)
+        if (open)
         {
-            for (Edge *nextEdge = head; nextEdge->next; nextEdge = nextEdge->next)
+            if (treeRoot[a] != treeRoot[b])
+                return false;  // Joins two trees: the forest has to be regrown
+            coverPath(a, b);
+            return true;
+        }
+        if (parent[b] == a && bridgeAbove[b])
+        {
+            splitBelow(b);
+            return true;
+        }
+        if (parent[a] == b && bridgeAbove[a])
+        {
+            splitBelow(a);
+            return true;
+        }
+        return false;  // Closing a road on a cycle may turn others into bridges
+    }
+
+public:
+    void refresh(const Graph &graph)
+    {
+        if (built && seenEpoch == graph.epoch)
+        {
+            return;
+        }
+
+        int count = graph.size < MAX_NODES ? graph.size : MAX_NODES;
+        bool full = !built || count != nodeCount;
+        nodeCount = count;
+
+        // Diff the open edges; a road between two intersections changes only when its count hits or leaves zero
+        int touched[2 * Graph::MAX_EDGES];
+        bool wasOpen[2 * Graph::MAX_EDGES];
+        int touchedCount = 0;
+        stamp++;
+        for (int id = 0; id < Graph::MAX_EDGES; ++id)
+        {
+            const Edge *edge = graph.getEdge(id);
+            bool open = graph.travelCost(id) != -1 && edge->destination - 'A' < count && graph.getEdgeSource(id) - 'A' < count;
+            int from = open ? graph.getEdgeSource(id) - 'A' : NONE;
+            int to = open ? edge->destination - 'A' : NONE;
+            if (from == linkFrom[id] && to == linkTo[id])
             {
-                if (nextEdge->destination > nextEdge->next->destination)
+                continue;
+            }
+
+            int ends[2][2] = {{linkFrom[id], linkTo[id]}, {from, to}};
+            for (int side = 0; side < 2; ++side)
+            {
+                if (ends[side][0] == NONE)
+                    continue;
+                int key = pairKey(ends[side][0], ends[side][1]);
+                if (touchedStamp[key] != stamp)
                 {
-                    char tempDestination = nextEdge->destination;
-                    nextEdge->destination = nextEdge->next->destination;
-                    nextEdge->next->destination = tempDestination;
+                    touchedStamp[key] = stamp;
+                    wasOpen[touchedCount] = linkCount[key] > 0;
+                    touched[touchedCount++] = key;
+                }
+                linkCount[key] += side == 0 ? -1 : 1;
+            }
+            linkFrom[id] = from;
+            linkTo[id] = to;
+        }
 
-                    int tempWeight = nextEdge->weight;
-                    nextEdge->weight = nextEdge->next->weight;
-                    nextEdge->next->weight = tempWeight;
+        // Closed roads first, then opened ones, each against the forest as it stands
+        bool changed = false;
+        for (int pass = 0; pass < 2 && !full; ++pass)
+        {
+            for (int i = 0; i < touchedCount && !full; ++i)
+            {
+                bool open = linkCount[touched[i]] > 0;
+                if (open == wasOpen[i] || open != (pass == 1))
+                {
+                    continue;
+                }
+                int a = touched[i] / MAX_NODES, b = touched[i] % MAX_NODES;
+                if (a != b)
+                {
+                    full = !applyLink(a, b, open);
+                    changed = true;
                 }
             }
         }
-        return head;
+
+        if (full)
+        {
+            rebuild(graph);
+        }
+        else if (changed)
+        {
+            articulationStale = true;  // Bridges are exact; articulation points are redone on demand
+        }
+        built = true;
+        seenEpoch = graph.epoch;
     }
 
-    Graph(int size)
+    bool isBridge(const Graph &graph, char a, char b)
     {
-        this->size = size;
-        nodes = new Node[size];
-        for (int i = 0; i < size; ++i)
+        refresh(graph);
+        int u = a - 'A', v = b - 'A';
+        if (u < 0 || v < 0 || u >= nodeCount || v >= nodeCount)
         {
-            nodes[i].name = '\0';
-            nodes[i].head = nullptr;
+            return false;
         }
+        return (parent[v] == u && bridgeAbove[v]) || (parent[u] == v && bridgeAbove[u]);
     }
 
-    ~Graph()
+    // Intersections cut off from a when the road a - b closes; returns how many (0 if it is not a bridge)
+    int cutOff(const Graph &graph, char a, char b, char region[])
     {
-        for (int i = 0; i < size; ++i)
+        if (!isBridge(graph, a, b))
         {
-            Edge *current = nodes[i].head;
-            while (current)
+            return 0;
+        }
+
+        // The side below the bridge is a subtree; if a is in it, the cut-off side is the rest of the tree
+        int u = a - 'A', v = b - 'A';
+        int child = (parent[v] == u) ? v : u;
+        bool aBelow = (child == u);
+        int first = preorder[child], last = preorder[child] + subtreeSize[child];
+        int root = treeRoot[child];
+
+        int count = 0;
+        for (int i = preorder[root]; i < preorder[root] + subtreeSize[root]; ++i)
+        {
+            bool below = i >= first && i < last;
+            if (treeRoot[nodeAt[i]] == root && below != aBelow)
             {
-                Edge *temp = current;
-                current = current->next;
-                delete temp;
+                region[count++] = nodeAt[i] + 'A';
             }
         }
-        delete[] nodes;
+        return count;
     }
 
-    void addEdge(char source, char destination, int weight)
+    // Warn before a closure takes effect if it splits the network
+    void reportClosure(const Graph &graph, char a, char b)
     {
-        Node *sourceNode = findOrCreateNode(source);
-
-        Edge *current = sourceNode->head;
-        while (current)
+        char region[MAX_NODES];
+        int count = cutOff(graph, a, b, region);
+        if (count == 0)
         {
-            if (current->destination == destination && current->weight == weight)
-            {
-                return;
-                // inorder to avoid duplicate edges
-            }
-            current = current->next;
+            return;
         }
 
-        Edge *newEdge = new Edge{destination, weight, sourceNode->head};
-        sourceNode->head = newEdge;
+        cout << "Warning: road " << a << " - " << b << " is a bridge; closing it cuts off " << count << " intersection(s) from " << a << ": ";
+        for (int i = 0; i < count; ++i)
+        {
+            cout << region[i] << (i + 1 < count ? ", " : "\n");
+        }
     }
 
-    bool removeEdge(char source, char destination)
+    void display(const Graph &graph)
     {
-        Node *sourceNode = findOrCreateNode(source);
-        Edge *current = sourceNode->head;
-        Edge *prev = nullptr;
+        refresh(graph);
+        if (articulationStale)
+        {
+            rebuild(graph);
+        }
 
-        while (current)
+        cout << "Bridges (roads whose closure splits the network):" << endl;
+        int bridges = 0;
+        for (int v = 0; v < nodeCount; ++v)
         {
-            if (current->destination == destination)
+            if (parent[v] != NONE && bridgeAbove[v])
             {
-                if (prev)
-                    prev->next = current->next;
-                else
-                    sourceNode->head = current->next;
+                int below = subtreeCount(v);
+                int above = subtreeCount(treeRoot[v]) - below;
+                cout << "  " << (char)(parent[v] + 'A') << " - " << (char)(v + 'A')
+                     << " (separates " << (below < above ? below : above) << " intersection(s))" << endl;
+                bridges++;
+            }
+        }
+        if (bridges == 0)
+        {
+            cout << "  none" << endl;
+        }
 
-                delete current;
-                return true;
+        cout << "Articulation intersections (closing one splits the network):";
+        int points = 0;
+        for (int v = 0; v < nodeCount; ++v)
+        {
+            if (graph.nodes[v].name != '\0' && articulation[v])
+            {
+                cout << " " << (char)(v + 'A');
+                points++;
             }
-            prev = current;
-            current = current->next;
         }
-        return false;
+        cout << (points == 0 ? " none" : "") << endl;
     }
 
-    void loadFromCSV(const char *filePath)
+    CriticalRoads()
     {
-        ifstream file(filePath);
-        if (!file.is_open())
+        for (int id = 0; id < Graph::MAX_EDGES; ++id)
         {
-            cout << "Error: Could not open file " << filePath << endl;
-            return;
+            linkFrom[id] = linkTo[id] = NONE;
+        }
+        for (int key = 0; key < MAX_NODES * MAX_NODES; ++key)
+        {
+            linkCount[key] = 0;
+            touchedStamp[key] = 0;
         }
+    }
+};
 
-        string line;
-        getline(file, line); 
+// Scheduled closures (accidents, roadworks) with a start and end time in simulation minutes
+// Every start and end is a timer in a hierarchical timer wheel: level 0 has one slot per minute,
+// each level above covers 64 times the span of the one below, and a slot is cascaded down a level
+// when the wheel below wraps. Advancing the clock only touches the slots it passes through.
+class ClosureSchedule
+{
+private:
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int LEVELS = 4;
+    static const int MAX_TIMERS = 2048;
+    static const int NO_TIMER = -1;
+    static const int MAX_DELAY = (1 << (SLOT_BITS * LEVELS)) - 1;
+
+    struct Timer
+    {
+        int expiry;
+        char start, end;
+        bool close;  // Closes the road when it fires, reopens it otherwise
+        int next;
+    };
 
-        while (getline(file, line))
+    Timer timers[MAX_TIMERS];
+    int wheel[LEVELS][SLOTS];
+    int freeTimer;
+    int pending;
+    int now;
+
+    int allocateTimer()
+    {
+        int t = freeTimer;
+        if (t != NO_TIMER)
         {
-            int index = 0;
-            char source = line[index];
-            index += 2; // Skipping the comma
-            char destination = line[index];
-            index += 2;
-            int travelTime = 0;
+            freeTimer = timers[t].next;
+        }
+        return t;
+    }
 
-            while (index < line.size() && line[index] >= '0' && line[index] <= '9')
-            {
-                travelTime = travelTime * 10 + (line[index] - '0');
-                index++;
-            }
+    // Put a timer in the slot that is reached at its expiry, on the lowest level that spans the delay
+    void insert(int t)
+    {
+        int delay = timers[t].expiry - now;
+        if (delay > MAX_DELAY)
+        {
+            delay = MAX_DELAY;  // Re-armed when it fires early
+        }
 
-            addEdge(source, destination, travelTime);
-            addEdge(destination, source, travelTime);
+        int level = 0;
+        while (level < LEVELS - 1 && delay >= (1 << (SLOT_BITS * (level + 1))))
+        {
+            level++;
         }
 
-        file.close();
+        int slot = ((now + delay) >> (SLOT_BITS * level)) & (SLOTS - 1);
+        timers[t].next = wheel[level][slot];
+        wheel[level][slot] = t;
     }
 
-    void updateCSV(const char *filePath)
+    void cascade(int level, int slot)
     {
-        ofstream file(filePath);
-        if (!file.is_open())
+        int t = wheel[level][slot];
+        wheel[level][slot] = NO_TIMER;
+        while (t != NO_TIMER)
         {
-            cout << "Error: Could not open file for updating.\n";
-            return;
+            int next = timers[t].next;
+            insert(t);
+            t = next;
         }
+    }
 
-        file << "Source,Destination,TravelTime\n"; 
+    void fire(Graph &graph, int t)
+    {
+        Timer &timer = timers[t];
 
-        for (int i = 0; i < size; ++i)
+        // Closures stack in the graph, so overlapping ones only reopen the road when the last one ends
+        if (timer.close)
         {
-            if (nodes[i].name == '\0')
-                continue;
-
-            Edge *current = nodes[i].head;
-            while (current)
+            if (graph.closeRoad(timer.start, timer.end))
             {
-                if (nodes[i].name < current->destination) 
-                {
-                    file << nodes[i].name << "," << current->destination << "," << current->weight << "\n";
-                }
-                current = current->next;
+                cout << "[" << formatTime(now) << "] Road " << timer.start << " - " << timer.end << " closed." << endl;
             }
         }
+        else if (graph.openRoad(timer.start, timer.end))
+        {
+            cout << "[" << formatTime(now) << "] Road " << timer.start << " - " << timer.end << " reopened." << endl;
+        }
 
-        file.close();
+        timer.next = freeTimer;
+        freeTimer = t;
+        pending--;
     }
 
-    void displayGraph()
+    // Move the clock one minute forward and fire what expires then
+    void tick(Graph &graph)
     {
-        cout << "----- City Traffic Network -----\n";
-        for (int i = 0; i < size; ++i)
+        now++;
+        for (int level = 1; level < LEVELS; ++level)
         {
-            if (nodes[i].name == '\0')
+            int shift = SLOT_BITS * level;
+            if ((now & ((1 << shift) - 1)) != 0)
             {
-                continue;
+                break;
             }
-           
-            nodes[i].head = sortEdges(nodes[i].head);
-
-            cout << nodes[i].name << " -> ";
-            Edge *current = nodes[i].head;
+            cascade(level, (now >> shift) & (SLOTS - 1));
+        }
 
-            while (current)
-            {
-                cout << "(" << current->destination << ", " << current->weight << ")";
-                if (current->next)
-                {
-                    cout << " ";
-                }
-                current = current->next;
-            }
-            cout << endl;
+        int slot = now & (SLOTS - 1);
+        int t = wheel[0][slot];
+        wheel[0][slot] = NO_TIMER;
+        while (t != NO_TIMER)
+        {
+            int next = timers[t].next;
+            if (timers[t].expiry > now)
+                insert(t);
+            else
+                fire(graph, t);
+            t = next;
         }
     }
 
-    void addRoad()
+    bool addTimer(Graph &graph, int expiry, char start, char end, bool close)
     {
-        char source, destination;
-        int weight;
-
-        cout << "Enter source intersection: ";
-        cin >> source;
-        cout << "Enter destination intersection: ";
-        cin >> destination;
-        cout << "Enter travel time (weight): ";
-        cin >> weight;
-
-        if (weight <= 0)
+        int t = allocateTimer();
+        if (t == NO_TIMER)
         {
-            cout << "Error: Weight must be a positive integer.\n";
-            return;
+            return false;
         }
+        timers[t] = {expiry, start, end, close, NO_TIMER};
+        pending++;
 
-        addEdge(source, destination, weight);
-        addEdge(destination, source, weight);
-        updateCSV("road_network.csv");
-        cout << "Road added successfully.\n";
+        if (expiry <= now)
+            fire(graph, t);
+        else
+            insert(t);
+        return true;
     }
 
-    void removeRoad()
+    // Accepts "HH:MM" or a plain number of minutes; -1 if empty or malformed
+    static int parseTime(const string &text)
     {
-        char source, destination;
-        cout << "Enter source intersection: ";
-        cin >> source;
-        cout << "Enter destination intersection: ";
-        cin >> destination;
-
-        if (removeEdge(source, destination) && removeEdge(destination, source))
+        int value = 0, hours = -1;
+        bool digits = false;
+        for (char c : text)
         {
-            updateCSV("road_network.csv");
-            cout << "Road removed successfully.\n";
+            if (c >= '0' && c <= '9')
+            {
+                value = value * 10 + (c - '0');
+                digits = true;
+            }
+            else if (c == ':' && hours == -1 && digits)
+            {
+                hours = value;
+                value = 0;
+                digits = false;
+            }
+            else if (c != ' ' && c != '\t' && c != '\r')
+            {
+                return -1;
+            }
+            if (value > MAX_DELAY)
+            {
+                return -1;
+            }
         }
-        else
+        if (!digits)
         {
-            cout << "Error: Road not found.\n";
+            return -1;
         }
+        return hours == -1 ? value : hours * 60 + value;
     }
 
-    void manageRoads()
+public:
+    ClosureSchedule() : freeTimer(0), pending(0), now(0)
     {
-        int choice;
-        do
+        for (int t = 0; t < MAX_TIMERS; ++t)
         {
-            cout << "\n1. Add a road\n";
-            cout << "2. Remove a road\n";
-            cout << "3. Return to main menu\n";
-            cout << "Enter your choice: ";
-            cin >> choice;
+            timers[t].next = (t + 1 < MAX_TIMERS) ? t + 1 : NO_TIMER;
+        }
+        for (int level = 0; level < LEVELS; ++level)
+        {
+            for (int slot = 0; slot < SLOTS; ++slot)
+            {
+                wheel[level][slot] = NO_TIMER;
+            }
+        }
+    }
 
-            if (choice == 1)
-                addRoad();
-            else if (choice == 2)
-                removeRoad();
-            else if (choice != 3)
-                cout << "Invalid choice. Try again.\n";
+    static string formatTime(int minutes)
+    {
+        string hh = to_string(minutes / 60), mm = to_string(minutes % 60);
+        return (hh.length() < 2 ? "0" : "") + hh + ":" + (mm.length() < 2 ? "0" : "") + mm;
+    }
+
+    int getTime() const
+    {
+        return now;
+    }
+
+    // Schedule a closure of the road between start and end for [from, to); to = -1 keeps it closed
+    bool schedule(Graph &graph, char start, char end, int from, int to)
+    {
+        if (!graph.isIntersection(start) || !graph.isIntersection(end) || (to != -1 && to <= from))
+        {
+            return false;
+        }
+        if (to != -1 && to <= now)
+        {
+            return true;  // Already over
+        }
+        if (pending + 2 > MAX_TIMERS)
+        {
+            cout << "Error: Too many scheduled closures." << endl;
+            return false;
+        }
 
-        } while (choice != 3);
+        addTimer(graph, from, start, end, true);
+        if (to != -1)
+        {
+            addTimer(graph, to, start, end, false);
+        }
+        return true;
     }
 
-    // Load blocked roads from a CSV file
-    void loadBlockedRoads(const char* filePath) 
+    // Load closures from a CSV of Intersection1,Intersection2,Start,End
+    void loadFromCSV(Graph &graph, const char *filePath)
     {
         ifstream file(filePath);
-        if (!file.is_open()) 
+        if (!file.is_open())
         {
-            cout << "Error: Could not open blocked roads file " << filePath << endl;
-            return;
+            return;  // The schedule is optional
         }
 
         string line;
         getline(file, line); // Skip the header line
 
-        while (getline(file, line)) 
+        while (getline(file, line))
         {
-            // Use stringstream to parse the CSV line
             stringstream ss(line);
-            string intersection1, intersection2, status;
-
-            // Extract the values separated by commas
-            getline(ss, intersection1, ','); // First intersection
-            getline(ss, intersection2, ','); // Second intersection
-            getline(ss, status, ',');        // Status of the road
-
-            // Manual trimming of leading whitespace
-            int start = 0;
-            while (start < status.length() && (status[start] == ' ' || status[start] == '\t')) 
-            {
-                start++;
-            }
-
-            // Manual trimming of trailing whitespace
-            int end = status.length() - 1;
-            while (end >= start && (status[end] == ' ' || status[end] == '\t')) 
-            {
-                end--;
-            }
-
-            // Extract the cleaned status string
-            string trimmedStatus = status.substr(start, end - start + 1);
+            string intersection1, intersection2, from, to;
+            getline(ss, intersection1, ',');
+            getline(ss, intersection2, ',');
+            getline(ss, from, ',');
+            getline(ss, to, ',');
 
-            // Only consider roads that are "Blocked"
-            if (trimmedStatus == "Blocked" && blockedRoadCount < MAX_BLOCKED_ROADS) 
+            int startTime = parseTime(from);
+            int endTime = parseTime(to);
+            if (intersection1.empty() || intersection2.empty() || startTime == -1 ||
+                !schedule(graph, intersection1[0], intersection2[0], startTime, endTime))
             {
-                blockedRoads[blockedRoadCount++] = {intersection1[0], intersection2[0]};
+                cout << "Skipping invalid scheduled closure: " << line << endl;
             }
         }
 
         file.close();
     }
 
-    // Function to check if a road is blocked
-    bool isRoadBlocked(char start, char end) const
+    // Advance the clock to the given time, applying and clearing closures on the way
+    void advanceTo(Graph &graph, int time)
     {
-        for (int i = 0; i < blockedRoadCount; ++i) 
+        while (now < time)
         {
-            if (blockedRoads[i].isBlocked(start, end)) 
+            if (pending == 0)
             {
-                return true;
+                now = time;  // Nothing to fire, jump straight there
+                break;
             }
+            tick(graph);
         }
-        return false;
     }
 
-    void dijkstra(char source, char destination, bool vehicle) const
+    void advance(Graph &graph)
     {
-        const int INF = 999999;  // Use a large number
-        int dist[100];  // Distance array
-        char prev[100];  // Array to store the previous node in the path
-        bool visited[100] = {false};  // Visited nodes to avoid reprocessing
-
-        // Initialize distance and previous arrays
-        for (int i = 0; i < size; ++i) 
+        int minutes;
+        cout << "Current simulation time: " << formatTime(now) << endl;
+        cout << "Enter minutes to advance: ";
+        cin >> minutes;
+        if (minutes < 0 || minutes > MAX_DELAY)
         {
-            dist[i] = INF;
-            prev[i] = '\0';
+            cout << "Invalid number of minutes." << endl;
+            return;
         }
 
-        dist[source - 'A'] = 0;  // Distance to source is 0
+        advanceTo(graph, now + minutes);
+        cout << "Simulation time is now " << formatTime(now) << " (" << pending << " scheduled changes pending)." << endl;
+    }
+};
+
+// Struct for Vehicles
+struct Vehicle 
+{
+    string vehicleID;
+    char startIntersection;
+    char endIntersection;
+    char currentIntersection; // Where the vehicle is currently
+    int routeHandle = -1; // Interned route in the simulator's shared RouteStore (-1 if none)
+};
 
-        PriorityQueue pq(size);
-        pq.insert(source, 0);  // Insert source with distance 0
+// Shared storage for vehicle routes
+// Each route is an edge ID sequence stored as zigzag deltas in LEB128 varints,
+// so consecutive edge IDs usually take a single byte. Routes are hash-consed:
+// identical sequences share one reference-counted entry.
+class RouteStore
+{
+private:
+    static const int BUCKET_COUNT = 1024;
 
-        while (!pq.isEmpty()) 
-        {
-            PriorityQueue::QueueNode minNode = pq.extractMin();
-            char current = minNode.vertex;
+    struct RouteEntry
+    {
+        int offset;        // First byte in the arena
+        int byteLength;    // Encoded size
+        int edgeCount;     // Number of encoded edges (-1 marks an unreachable route)
+        int refCount;      // Holders of this handle
+        unsigned int hash; // Hash of the encoded bytes
+        int next;          // Next entry in the bucket chain, or in the free list
+    };
 
-            if (visited[current - 'A']) 
-            {
-                continue;  // Skip if already visited
-            }
+    unsigned char *bytes;
+    int byteCount;
+    int byteCapacity;
+    int garbageBytes;  // Bytes of released or replaced routes, reclaimed by compact()
 
-            visited[current - 'A'] = true;  // Mark the current node as visited
+    RouteEntry *entries;
+    int entryCount;
+    int entryCapacity;
+    int freeEntry;     // Head of the list of released entries
 
-            Node *node = &nodes[current - 'A'];
+    int buckets[BUCKET_COUNT];
 
-            for (Edge *edge = node->head; edge != nullptr; edge = edge->next) 
-            {
-                // Skip the edge if it's blocked
-                if (isRoadBlocked(current, edge->destination)) 
-                {
-                    continue;
-                }
+    void reserveBytes(int extra)
+    {
+        if (byteCount + extra <= byteCapacity)
+            return;
 
-                if (!visited[edge->destination - 'A']) 
-                {
-                    int newDist = dist[current - 'A'] + edge->weight;
+        int newCapacity = byteCapacity * 2;
+        while (newCapacity < byteCount + extra)
+            newCapacity *= 2;
 
-                    if (newDist < dist[edge->destination - 'A']) 
-                    {
-                        dist[edge->destination - 'A'] = newDist;
-                        prev[edge->destination - 'A'] = current;
-                        pq.insert(edge->destination, newDist);
-                    }
-                }
-            }
+        unsigned char *newBytes = new unsigned char[newCapacity];
+        memcpy(newBytes, bytes, byteCount);
+        delete[] bytes;
+        bytes = newBytes;
+        byteCapacity = newCapacity;
+    }
+
+    void writeVarint(unsigned int value)
+    {
+        while (value >= 0x80)
+        {
+            bytes[byteCount++] = (unsigned char)(value | 0x80);
+            value >>= 7;
         }
+        bytes[byteCount++] = (unsigned char)value;
+    }
 
-        // Check if a valid path exists
-        if (dist[destination - 'A'] == INF) 
+    // Encode at the end of the arena without committing; returns the encoded length
+    int encode(const int edgeIds[], int count)
+    {
+        reserveBytes(count * 5);  // Worst case: 5 varint bytes per edge
+
+        int start = byteCount;
+        int previous = 0;
+        for (int i = 0; i < count; i++)
         {
-            cout << "No route found from " << source << " to " << destination << endl;
-            return;  // No route found, exit the function
+            int delta = edgeIds[i] - previous;
+            writeVarint(((unsigned int)delta << 1) ^ (unsigned int)(delta >> 31));
+            previous = edgeIds[i];
         }
 
-        if (!vehicle)
+        int length = byteCount - start;
+        byteCount = start;
+        return length;
+    }
+
+    // FNV-1a over the encoded bytes
+    unsigned int hashBytes(const unsigned char *data, int length, int count) const
+    {
+        unsigned int hash = 2166136261u ^ (unsigned int)count;
+        for (int i = 0; i < length; i++)
         {
-            // If a valid path exists, print the path
-            cout << "Path from " << source << " to " << destination << ": ";
+            hash ^= data[i];
+            hash *= 16777619u;
         }
+        return hash;
+    }
 
-        // To trace the path, we start from destination and move backwards using prev
-        char path[100];
-        int pathIndex = 0;
+    int newEntry()
+    {
+        if (freeEntry != -1)
+        {
+            int handle = freeEntry;
+            freeEntry = entries[handle].next;
+            return handle;
+        }
 
-        for (char at = destination; at != '\0'; at = prev[at - 'A']) 
+        if (entryCount == entryCapacity)
         {
-            path[pathIndex++] = at;
+            RouteEntry *newEntries = new RouteEntry[entryCapacity * 2];
+            for (int i = 0; i < entryCount; i++)
+                newEntries[i] = entries[i];
+            delete[] entries;
+            entries = newEntries;
+            entryCapacity *= 2;
         }
+        return entryCount++;
+    }
 
-        // Print path in reverse order with arrows
-        for (int i = pathIndex - 1; i >= 0; --i) 
+    void link(int handle)
+    {
+        int bucket = entries[handle].hash % BUCKET_COUNT;
+        entries[handle].next = buckets[bucket];
+        buckets[bucket] = handle;
+    }
+
+    void unlink(int handle)
+    {
+        int bucket = entries[handle].hash % BUCKET_COUNT;
+        int *link = &buckets[bucket];
+        while (*link != -1)
         {
-            cout << path[i];
-            if (i > 0) 
+            if (*link == handle)
             {
-                cout << " -> ";
+                *link = entries[handle].next;
+                return;
             }
+            link = &entries[*link].next;
         }
+    }
 
-        cout << "\nTotal distance: " << dist[destination - 'A'] << endl;
+    // Move the pending encoding at the end of the arena into an entry
+    void commit(int handle, int length, int count, unsigned int hash)
+    {
+        entries[handle].offset = byteCount;
+        entries[handle].byteLength = length;
+        entries[handle].edgeCount = count;
+        entries[handle].hash = hash;
+        byteCount += length;
+        link(handle);
     }
 
-    void dfs(char current, char end, char currentPath[], int &currentIndex,
-            char paths[][100], int pathWeights[], int &pathCount, int currentWeight,
-            bool visited[]) 
+    // Rewrite the arena with only live routes once garbage dominates
+    void compactIfNeeded()
     {
-        visited[current - 'A'] = true;
-        currentPath[currentIndex++] = current;
+        if (garbageBytes < 4096 || garbageBytes * 2 < byteCount)
+            return;
 
-        if (current == end) 
+        unsigned char *newBytes = new unsigned char[byteCapacity];
+        int newCount = 0;
+        for (int i = 0; i < entryCount; i++)
         {
-            // Save the path
-            if (pathCount < 100) 
+            if (entries[i].refCount > 0 && entries[i].edgeCount > 0)
             {
-                for (int i = 0; i < currentIndex; ++i) 
-                {
-                    paths[pathCount][i] = currentPath[i];
-                }
-                paths[pathCount][currentIndex] = '\0'; // Null-terminate
-                pathWeights[pathCount] = currentWeight;
-                pathCount++;
+                memcpy(newBytes + newCount, bytes + entries[i].offset, entries[i].byteLength);
+                entries[i].offset = newCount;
+                newCount += entries[i].byteLength;
             }
-        } 
-        else 
+        }
+
+        delete[] bytes;
+        bytes = newBytes;
+        byteCount = newCount;
+        garbageBytes = 0;
+    }
+
+public:
+    // Decodes one route lazily, an edge at a time
+    class Iterator
+    {
+    private:
+        const unsigned char *pos;
+        int remaining;
+        int current;
+
+    public:
+        Iterator(const unsigned char *start, int edgeCount)
+            : pos(start), remaining(edgeCount), current(0) {}
+
+        bool next(int &edgeId)
         {
-            // Visit all neighbors sorted by destination
-            Node *nodePtr = findOrCreateNode(current);
-            
-            // Sort edges by destination before traversing them
-            Edge* sortedHead = sortEdges(nodePtr->head);
-            
-            for (Edge *edge = sortedHead; edge != nullptr; edge = edge->next) 
+            if (remaining <= 0)
+                return false;
+
+            unsigned int value = 0;
+            int shift = 0;
+            while (*pos & 0x80)
             {
-                if (!visited[edge->destination - 'A']) 
-                {
-                    dfs(edge->destination, end, currentPath, currentIndex, paths, pathWeights, pathCount, currentWeight + edge->weight, visited);
-                }
+                value |= (unsigned int)(*pos++ & 0x7F) << shift;
+                shift += 7;
             }
+            value |= (unsigned int)(*pos++) << shift;
+
+            current += (int)(value >> 1) ^ -(int)(value & 1);
+            edgeId = current;
+            remaining--;
+            return true;
         }
+    };
 
-        // Backtrack
-        visited[current - 'A'] = false;
-        currentIndex--;
+    RouteStore() : byteCount(0), byteCapacity(256), garbageBytes(0), entryCount(0), entryCapacity(16), freeEntry(-1)
+    {
+        bytes = new unsigned char[byteCapacity];
+        entries = new RouteEntry[entryCapacity];
+        for (int i = 0; i < BUCKET_COUNT; i++)
+            buckets[i] = -1;
     }
 
-    void findAllPaths(char start, char end) 
+    ~RouteStore()
     {
-        const int MAX_PATHS = 100;  // Maximum number of paths to store
-        const int MAX_NODES = 100;  // Maximum nodes in a graph
-
-        char paths[MAX_PATHS][MAX_NODES];  // To store all paths
-        int pathWeights[MAX_PATHS];         // To store weights of each path
-        int pathCount = 0;                  // Number of paths found
-
-        bool visited[26] = {false};
-        char currentPath[100];
-        int currentIndex = 0;
+        delete[] bytes;
+        delete[] entries;
+    }
 
-        dfs(start, end, currentPath, currentIndex, paths, pathWeights, pathCount, 0, visited);
+    // Return the handle of an identical stored route, or store a new one; the caller holds one reference
+    int intern(const int edgeIds[], int count)
+    {
+        int length = encode(edgeIds, count);
+        unsigned int hash = hashBytes(bytes + byteCount, length, count);
 
-        // Display all paths and their weights
-        cout << "All possible paths from " << start << " to " << end << " are:\n";
-        for (int i = 0; i < pathCount; ++i) 
+        for (int h = buckets[hash % BUCKET_COUNT]; h != -1; h = entries[h].next)
         {
-            cout << "Path: ";
-            for (int j = 0; paths[i][j] != '\0'; ++j) 
+            if (entries[h].hash == hash && entries[h].edgeCount == count && entries[h].byteLength == length &&
+                memcmp(bytes + entries[h].offset, bytes + byteCount, length) == 0)
             {
-                cout << paths[i][j];
-                if (paths[i][j + 1] != '\0') 
-                {
-                    cout << " -> ";
-                }
+                entries[h].refCount++;
+                return h;
             }
-            cout << " | Total Weight: " << pathWeights[i] << endl;
         }
+
+        int handle = newEntry();
+        entries[handle].refCount = 1;
+        commit(handle, length, count, hash);
+        return handle;
     }
 
-    
-};
+    void acquire(int handle)
+    {
+        entries[handle].refCount++;
+    }
 
-// Struct for Vehicles
-struct Vehicle 
-{
-    string vehicleID;
-    char startIntersection;
-    char endIntersection;
-    char currentIntersection; // Where the vehicle is currently
-    char route[100]; // Fixed-size array for the route
-    int routeLength; // Number of elements in the route
+    void release(int handle)
+    {
+        if (--entries[handle].refCount > 0)
+            return;
+
+        if (entries[handle].edgeCount >= 0)
+        {
+            unlink(handle);
+            garbageBytes += entries[handle].byteLength;
+        }
+        entries[handle].next = freeEntry;
+        freeEntry = handle;
+        compactIfNeeded();
+    }
+
+    // Reroute every holder of a handle at once; a count of -1 marks the route unreachable
+    void replace(int handle, const int edgeIds[], int count)
+    {
+        if (entries[handle].edgeCount >= 0)
+        {
+            unlink(handle);
+            garbageBytes += entries[handle].byteLength;
+        }
+
+        if (count < 0)
+        {
+            entries[handle].edgeCount = -1;
+            entries[handle].byteLength = 0;
+        }
+        else
+        {
+            int length = encode(edgeIds, count);
+            commit(handle, length, count, hashBytes(bytes + byteCount, length, count));
+        }
+        compactIfNeeded();
+    }
+
+    Iterator begin(int handle) const
+    {
+        return Iterator(bytes + entries[handle].offset, entries[handle].edgeCount);
+    }
+
+    int getEdgeCount(int handle) const
+    {
+        return entries[handle].edgeCount;
+    }
+
+    int getByteCount() const
+    {
+        return byteCount - garbageBytes;
+    }
 };
 
 // Struct for Intersections
@@ -918,13 +5526,13 @@ public:
     // Getter for density
     int getDensity() const 
     {
-        return intersectionInfo.density;
+        return __atomic_load_n(&intersectionInfo.density, __ATOMIC_RELAXED);
     }
 
     // Setter for density
     void setDensity(int newDensity) 
     {
-        intersectionInfo.density = newDensity;
+        __atomic_store_n(&intersectionInfo.density, newDensity, __ATOMIC_RELAXED);
     }
 
     // Method to increment green time based on density
@@ -933,10 +5541,10 @@ public:
         intersectionInfo.greenTime += additionalTime;
     }
 
-    // Method to increment density
+    // Method to increment density (relaxed atomic, so ingestion threads can share a signal)
     void incrementDensity() 
     {
-        intersectionInfo.density++;
+        __atomic_fetch_add(&intersectionInfo.density, 1, __ATOMIC_RELAXED);
     }
 
     // Print function for traffic signal info
@@ -1072,10 +5680,113 @@ private:
     TrafficSignal signals[MAX_SIGNALS];
     int vehicleCount;
     int signalCount;
+    HashIndex<string> vehicleIndex; // Vehicle ID -> index into vehicles[]
+    HashIndex<int> signalIndex;     // Intersection -> index into signals[]
     MaxHeap signalQueue;
+    RouteStore routeStore;  // Encoded routes shared by all vehicles
+    int pairRoute[26][26];  // Shared route handle per start/end pair (-1 if not computed yet)
+    int pairEpoch[26][26];  // Graph epoch each pair route was computed for
+
+    // Inverted index: edge ID -> vehicles whose current route uses it, as linked postings
+    static const int MAX_ROUTE_EDGES = 100;
+    static const int MAX_POSTINGS = MAX_VEHICLES * MAX_ROUTE_EDGES;
+    int edgeVehicles[Graph::MAX_EDGES];  // First posting of each edge (-1 if none)
+    int postingVehicle[MAX_POSTINGS];
+    int postingNext[MAX_POSTINGS];        // Next posting of the same edge, or next free posting
+    int freePosting;
+
+    // State of the last closure sweep
+    Bitset sweptClosures;
+    int sweptEpoch;
+    int sweptRerouteEpoch;
+
+    // Add or remove a vehicle's postings for every edge of its current route
+    void indexVehicle(int v, bool add)
+    {
+        int handle = vehicles[v].routeHandle;
+        if (handle == -1 || routeStore.getEdgeCount(handle) <= 0)
+        {
+            return;
+        }
+
+        int edgeId;
+        RouteStore::Iterator it = routeStore.begin(handle);
+        while (it.next(edgeId))
+        {
+            if (add)
+            {
+                int p = freePosting;
+                if (p == -1)
+                {
+                    return;  // Cannot happen: routes are at most MAX_ROUTE_EDGES long
+                }
+                freePosting = postingNext[p];
+                postingVehicle[p] = v;
+                postingNext[p] = edgeVehicles[edgeId];
+                edgeVehicles[edgeId] = p;
+                continue;
+            }
+
+            int *link = &edgeVehicles[edgeId];
+            while (*link != -1 && postingVehicle[*link] != v)
+            {
+                link = &postingNext[*link];
+            }
+            if (*link != -1)
+            {
+                int p = *link;
+                *link = postingNext[p];
+                postingNext[p] = freePosting;
+                freePosting = p;
+            }
+        }
+    }
+
+    // Index or unindex every vehicle holding a route handle
+    void indexHolders(int handle, bool add)
+    {
+        for (int v = 0; v < vehicleCount; v++)
+        {
+            if (vehicles[v].routeHandle == handle)
+            {
+                indexVehicle(v, add);
+            }
+        }
+    }
+
+    // Signal at an intersection (-1 if it has none)
+    int findSignal(char intersection) const
+    {
+        return signalIndex.find(intersection);
+    }
 
 public:
-    TrafficSimulator() : vehicleCount(0), signalCount(0), signalQueue(MAX_SIGNALS) {}
+    // Index of a vehicle by ID (-1 if unknown)
+    int findVehicle(const string &vehicleID) const
+    {
+        return vehicleIndex.find(vehicleID);
+    }
+
+    TrafficSimulator() : vehicleCount(0), signalCount(0), signalQueue(MAX_SIGNALS), freePosting(0),
+                         sweptEpoch(-1), sweptRerouteEpoch(-1)
+    {
+        for (int i = 0; i < 26; i++)
+        {
+            for (int j = 0; j < 26; j++)
+            {
+                pairRoute[i][j] = -1;
+                pairEpoch[i][j] = -1;
+            }
+        }
+        for (int id = 0; id < Graph::MAX_EDGES; id++)
+        {
+            edgeVehicles[id] = -1;
+        }
+        for (int p = 0; p < MAX_POSTINGS; p++)
+        {
+            postingNext[p] = (p + 1 < MAX_POSTINGS) ? p + 1 : -1;
+        }
+    }
 
     // Load vehicles from CSV file
     void loadVehiclesFromCSV(const char* filePath) 
@@ -1109,18 +5820,18 @@ public:
 
             // Add the vehicle to the vehicles array
             vehicles[vehicleCount] = {vehicleID, startIntersection, endIntersection, startIntersection};
+            if (vehicleIndex.find(vehicleID) == -1)
+            {
+                vehicleIndex.set(vehicleID, vehicleCount);
+            }
             vehicleCount++;
 
             // Update the density of the destination intersection
-            // Update the density of the destination intersection
-            for (int i = 0; i < signalCount; i++) 
+            int signal = findSignal(endIntersection);
+            if (signal != -1)
             {
-                if (signals[i].getIntersectionID() == endIntersection) 
-                {
-                    signals[i].incrementDensity();  // Increase the density of the destination intersection
-                    cout << "Density increased at intersection " << endIntersection << endl;  // Debugging line
-                    break; // Stop once the corresponding intersection is found
-                }
+                signals[signal].incrementDensity();  // Increase the density of the destination intersection
+                cout << "Density increased at intersection " << endIntersection << endl;  // Debugging line
             }
 
         }
@@ -1157,6 +5868,10 @@ public:
 
             // Using the constructor with two arguments
             signals[signalCount] = TrafficSignal(intersection, greenTime);
+            if (signalIndex.find(intersection) == -1)
+            {
+                signalIndex.set(intersection, signalCount);
+            }
 
             signalCount++;
         }
@@ -1182,15 +5897,10 @@ public:
 
         for (int i = 0; i < vehicleCount; i++) 
         {
-            char destinationIntersection = vehicles[i].endIntersection;
-            
-            for (int j = 0; j < signalCount; j++) 
+            int signal = findSignal(vehicles[i].endIntersection);
+            if (signal != -1)
             {
-                if (signals[j].getIntersectionID() == destinationIntersection) 
-                {
-                    signals[j].incrementDensity();
-                    break;
-                }
+                signals[signal].incrementDensity();
             }
         }
     }
@@ -1227,6 +5937,11 @@ public:
 
             cout << "Enter vehicle ID: ";
             cin >> vehicleID;
+            if (findVehicle(vehicleID) != -1)
+            {
+                cout << "Error: Vehicle " << vehicleID << " already exists." << endl;
+                return;
+            }
 
             cout << "Enter start intersection: ";
             cin >> startIntersection;
@@ -1236,17 +5951,15 @@ public:
 
             // Add the new vehicle
             vehicles[vehicleCount] = {vehicleID, startIntersection, endIntersection, startIntersection};
+            vehicleIndex.set(vehicleID, vehicleCount);
             vehicleCount++;
 
             // Update the density of the destination intersection
-            for (int i = 0; i < signalCount; i++) 
+            int signal = findSignal(endIntersection);
+            if (signal != -1)
             {
-                if (signals[i].getIntersectionID() == endIntersection) 
-                {
-                    signals[i].incrementDensity();  // Increase the density
-                    cout << "Vehicle added. Density increased at intersection " << endIntersection << endl;
-                    break;
-                }
+                signals[signal].incrementDensity();  // Increase the density
+                cout << "Vehicle added. Density increased at intersection " << endIntersection << endl;
             }
 
             // Update green time based on density after adding the vehicle
@@ -1288,7 +6001,136 @@ public:
             << ": " << newGreenTime << endl;
     }
 
-    // Display vehicle information
+    // Give the vehicle the shared route of its start/end pair
+    // A stale pair route is recomputed once and replaced in place, which reroutes every vehicle holding it
+    void assignRoute(int v, const Graph& graph) 
+    {
+        Vehicle& vehicle = vehicles[v];
+        int s = vehicle.startIntersection - 'A';
+        int e = vehicle.endIntersection - 'A';
+        if (s < 0 || s >= 26 || e < 0 || e >= 26)
+        {
+            return;
+        }
+
+        if (pairEpoch[s][e] != graph.epoch)
+        {
+            int edgeIds[MAX_ROUTE_EDGES];
+            int count = graph.shortestPathEdges(vehicle.startIntersection, vehicle.endIntersection, edgeIds, MAX_ROUTE_EDGES);
+
+            if (pairRoute[s][e] == -1)
+            {
+                pairRoute[s][e] = (count == -1) ? -1 : routeStore.intern(edgeIds, count);
+            }
+            else
+            {
+                indexHolders(pairRoute[s][e], false);
+                routeStore.replace(pairRoute[s][e], edgeIds, count);
+                indexHolders(pairRoute[s][e], true);
+            }
+            pairEpoch[s][e] = graph.epoch;
+        }
+
+        if (vehicle.routeHandle != pairRoute[s][e] && pairRoute[s][e] != -1)
+        {
+            if (vehicle.routeHandle != -1)
+            {
+                indexVehicle(v, false);
+                routeStore.release(vehicle.routeHandle);
+            }
+            routeStore.acquire(pairRoute[s][e]);
+            vehicle.routeHandle = pairRoute[s][e];
+            indexVehicle(v, true);
+        }
+    }
+
+    // Reroute exactly the vehicles whose route uses a road closed since the last sweep
+    // Closures never make a route shorter, so unless roads were added, removed or reopened in the
+    // meantime, every other stored route is still a shortest route and is kept as it is
+    void rerouteClosedRoads(const Graph& graph)
+    {
+        bool affected[MAX_VEHICLES] = {false};
+        int affectedCount = 0;
+        for (int id = 0; id < Graph::MAX_EDGES; id++)
+        {
+            bool closed = graph.isEdgeClosed(id);
+            if (closed && !sweptClosures.test(id))
+            {
+                for (int p = edgeVehicles[id]; p != -1; p = postingNext[p])
+                {
+                    if (!affected[postingVehicle[p]])
+                    {
+                        affected[postingVehicle[p]] = true;
+                        affectedCount++;
+                    }
+                }
+            }
+
+            if (closed)
+                sweptClosures.set(id);
+            else
+                sweptClosures.reset(id);
+        }
+
+        if (graph.rerouteEpoch == sweptRerouteEpoch)
+        {
+            bool stalePair[26][26] = {{false}};
+            for (int v = 0; v < vehicleCount; v++)
+            {
+                int s = vehicles[v].startIntersection - 'A';
+                int e = vehicles[v].endIntersection - 'A';
+                if (affected[v] && s >= 0 && s < 26 && e >= 0 && e < 26)
+                    stalePair[s][e] = true;
+            }
+            for (int s = 0; s < 26; s++)
+            {
+                for (int e = 0; e < 26; e++)
+                {
+                    if (pairRoute[s][e] != -1 && pairEpoch[s][e] >= sweptEpoch && !stalePair[s][e])
+                        pairEpoch[s][e] = graph.epoch;
+                }
+            }
+        }
+        sweptEpoch = graph.epoch;
+        sweptRerouteEpoch = graph.rerouteEpoch;
+
+        for (int v = 0; v < vehicleCount; v++)
+        {
+            if (affected[v])
+            {
+                assignRoute(v, graph);
+                cout << "Vehicle " << vehicles[v].vehicleID << " rerouted around closed roads: ";
+                printRoute(vehicles[v], graph);
+            }
+        }
+        if (affectedCount == 0)
+        {
+            cout << "No vehicle routes use the closed roads." << endl;
+        }
+    }
+
+    // Decode a stored route and print it along with its total travel time
+    void printRoute(const Vehicle& vehicle, const Graph& graph) const
+    {
+        if (vehicle.routeHandle == -1 || routeStore.getEdgeCount(vehicle.routeHandle) == -1) 
+        {
+            cout << "No route found from " << vehicle.startIntersection << " to " << vehicle.endIntersection << endl;
+            return;
+        }
+
+        cout << vehicle.startIntersection;
+        int totalDistance = 0;
+        int edgeId;
+        RouteStore::Iterator it = routeStore.begin(vehicle.routeHandle);
+        while (it.next(edgeId)) 
+        {
+            const Edge *edge = graph.getEdge(edgeId);
+            cout << " -> " << edge->destination;
+            totalDistance += edge->weight;
+        }
+        cout << "\nTotal distance: " << totalDistance << endl;
+    }
+
     // Display vehicle information with route
     void displayVehiclesInfo(Graph& graph) 
     {
@@ -1301,9 +6143,11 @@ public:
                 << " to " << vehicles[i].endIntersection
                 << endl;
 
-            // Call the dijkstra function to print the route for each vehicle
+            // Routes are recomputed only when the network changed since they were stored
+            assignRoute(i, graph);
+
             cout << "Route: ";
-            graph.dijkstra(vehicles[i].startIntersection, vehicles[i].endIntersection, true);
+            printRoute(vehicles[i], graph);
         }
     }
 
@@ -1335,107 +6179,249 @@ private:
     string intersections[MAX_INTERSECTIONS];
     int adjMatrix[MAX_INTERSECTIONS][MAX_INTERSECTIONS]; // Adjacency matrix
     int heuristic[MAX_INTERSECTIONS];                   // Heuristic values for A*
-    RoadClosure roadClosures[MAX_INTERSECTIONS * MAX_INTERSECTIONS];
+    int searchOffset[MAX_INTERSECTIONS + 1];            // Open roads in contiguous form for aStar()
+    int searchTarget[MAX_INTERSECTIONS * MAX_INTERSECTIONS];
+    int searchRoad[MAX_INTERSECTIONS * MAX_INTERSECTIONS];
+    int searchWeight[MAX_INTERSECTIONS * MAX_INTERSECTIONS];
+    RoadClosure roadClosures[MAX_INTERSECTIONS * MAX_INTERSECTIONS]; // Rows of road_closures.csv
     int intersectionCount;
     int roadClosureCount;
+    HashIndex<string> intersectionIndex; // Intersection name -> index into intersections[]
+    HashIndex<string> closureIndex;      // closureKey() of a road -> its record in roadClosures[]
+
+    // Closed roads for the searches, bit i * MAX_INTERSECTIONS + j per direction
+    static_assert(MAX_INTERSECTIONS * MAX_INTERSECTIONS <= Bitset::MAX_BITS, "closure bits must fit the bitset");
+    Bitset closedRoads;
+    EditJournal closureJournal; // Closures since road_closures.csv was last written
+
+    // Slowdowns and intersection closures mirrored from the Graph, keyed like closedRoads
+    static_assert(MAX_INTERSECTIONS * MAX_INTERSECTIONS <= WeightOverlay::MAX_EDGES, "road keys must fit the overlay");
+    WeightOverlay overlay;
+    ConnectivityIndex connectivity; // Components of the open roads, so unreachable trips skip aStar()
+
+    // Facilities (hospitals, fire stations) and the reverse search tree towards them
+    int facilities[MAX_INTERSECTIONS];
+    string facilityTypes[MAX_INTERSECTIONS];
+    int facilityCount;
+    int facilityDist[MAX_INTERSECTIONS];    // Travel time to the nearest facility
+    int facilityNext[MAX_INTERSECTIONS];    // Next hop towards the nearest facility (-1 at a facility)
+    int nearestFacility[MAX_INTERSECTIONS]; // Index into facilities[] (-1 if none reachable)
+    bool facilityTreeValid;
 
     // Get the index of an intersection
     int getIntersectionIndex(const string& intersection) {
-        for (int i = 0; i < intersectionCount; ++i) {
-            if (intersections[i] == intersection) {
-                return i;
-            }
+        return intersectionIndex.find(intersection);
+    }
+
+    // Get the index of an intersection, adding it if it is new (-1 if there is no room)
+    int findOrAddIntersection(const string& intersection) {
+        int idx = getIntersectionIndex(intersection);
+        if (idx == -1 && intersectionCount < MAX_INTERSECTIONS) {
+            intersections[intersectionCount++] = intersection;
+            idx = intersectionCount - 1;
+            intersectionIndex.set(intersection, idx);
         }
-        return -1;
+        return idx;
+    }
+
+    // Insert or update the record of a closure, kept for road_closures.csv
+    bool setClosureRecord(const string& intersection1, const string& intersection2, const string& status) {
+        int i = closureIndex.find(closureKey(intersection1, intersection2));
+        if (i != -1) {
+            roadClosures[i].status = status;
+            return true;
+        }
+
+        if (roadClosureCount >= MAX_INTERSECTIONS * MAX_INTERSECTIONS) {
+            return false;
+        }
+        addClosureRecord(intersection1, intersection2, status);
+        return true;
+    }
+
+    // Append a closure record; the first record of a road is the one later updates go to
+    void addClosureRecord(const string& intersection1, const string& intersection2, const string& status) {
+        string key = closureKey(intersection1, intersection2);
+        if (closureIndex.find(key) == -1) {
+            closureIndex.set(key, roadClosureCount);
+        }
+        roadClosures[roadClosureCount].intersection1 = intersection1;
+        roadClosures[roadClosureCount].intersection2 = intersection2;
+        roadClosures[roadClosureCount].status = status;
+        roadClosureCount++;
+    }
+
+    // Key of a road in closureIndex, the same in both directions
+    static string closureKey(const string& intersection1, const string& intersection2) {
+        return intersection1 < intersection2 ? intersection1 + "," + intersection2 : intersection2 + "," + intersection1;
+    }
+
+    // The closure records in road_closures.csv format
+    string closuresCSV() const {
+        stringstream out;
+        for (int i = 0; i < roadClosureCount; ++i) {
+            out << roadClosures[i].intersection1 << ","
+                << roadClosures[i].intersection2 << ","
+                << roadClosures[i].status << endl;
+        }
+        return out.str();
     }
 
     // A* algorithm to find the shortest path
     void aStar(int start, int end, int parent[]) {
-        int openSet[MAX_INTERSECTIONS];
-        bool closedSet[MAX_INTERSECTIONS] = {false};
-        int gScore[MAX_INTERSECTIONS]; // Cost from start to each intersection
-        int fScore[MAX_INTERSECTIONS]; // Estimated cost (gScore + heuristic)
+        int sources[1] = {start};
 
-        // Initialize scores and openSet
+        SearchGraph<int> view = {intersectionCount, searchOffset, searchTarget, searchRoad, searchWeight};
+        OverlayFilter<ClosureFilter> filter = {ClosureFilter{&closedRoads}, &overlay};
+        Router<int, BinaryHeapQueue, OverlayFilter<ClosureFilter>, TableHeuristic> router(view, filter, TableHeuristic{heuristic});
+        router.search(sources, 1, end);
+
+        // Hand back only the parents on the path; everything else reads as unreached
+        const SearchWorkspace<BinaryHeapQueue> &workspace = router.getWorkspace();
         for (int i = 0; i < intersectionCount; ++i) {
-            gScore[i] = INF;
-            fScore[i] = INF;
-            openSet[i] = 0;
             parent[i] = -1;
         }
+        for (int at = end; workspace.getParent(at) != -1; at = workspace.getParent(at)) {
+            parent[at] = workspace.getParent(at);
+        }
+    }
+
+    // Rebuild the contiguous copy of the roads that aStar() searches (closures are filtered by bit)
+    void buildSearchGraph() {
+        int position = 0;
+        for (int i = 0; i < intersectionCount; ++i) {
+            searchOffset[i] = position;
+            for (int j = 0; j < intersectionCount; ++j) {
+                if (adjMatrix[i][j] == INF) {
+                    continue;
+                }
+                searchTarget[position] = j;
+                searchRoad[position] = i * MAX_INTERSECTIONS + j;
+                searchWeight[position] = adjMatrix[i][j];
+                position++;
+            }
+        }
+        searchOffset[intersectionCount] = position;
+    }
+
+    // Multi-source Dijkstra run backwards from every facility, so each intersection
+    // learns its nearest facility and the next hop on the way there
+    void buildFacilityTree() {
+        bool done[MAX_INTERSECTIONS] = {false};
+
+        for (int i = 0; i < intersectionCount; ++i) {
+            facilityDist[i] = INF;
+            facilityNext[i] = -1;
+            nearestFacility[i] = -1;
+        }
 
-        gScore[start] = 0;
-        fScore[start] = heuristic[start];
-        openSet[start] = 1;
+        for (int f = 0; f < facilityCount; ++f) {
+            if (overlay.isNodeClosed(facilities[f])) {
+                continue;
+            }
+            facilityDist[facilities[f]] = 0;
+            nearestFacility[facilities[f]] = f;
+        }
 
         while (true) {
-            // Find the node in the openSet with the smallest fScore
-            int current = -1, lowestFScore = INF;
+            int current = -1, lowest = INF;
             for (int i = 0; i < intersectionCount; ++i) {
-                if (openSet[i] && fScore[i] < lowestFScore) {
-                    lowestFScore = fScore[i];
+                if (!done[i] && facilityDist[i] < lowest) {
+                    lowest = facilityDist[i];
                     current = i;
                 }
             }
 
             if (current == -1) {
-                // No valid path
-                return;
+                break;
             }
+            done[current] = true;
 
-            // If the destination is reached
-            if (current == end) {
-                return;
-            }
-
-            // Move current from openSet to closedSet
-            openSet[current] = 0;
-            closedSet[current] = true;
-
-            // Check neighbors of the current node
-            for (int neighbor = 0; neighbor < intersectionCount; ++neighbor) {
-                if (adjMatrix[current][neighbor] == INF || closedSet[neighbor]) {
-                    continue; // Skip if no connection or already visited
+            // Relax roads leading into current (reverse direction)
+            for (int from = 0; from < intersectionCount; ++from) {
+                if (done[from] || adjMatrix[from][current] == INF) {
+                    continue;
                 }
 
-                if (isRoadBlocked(intersections[current], intersections[neighbor])) {
-                    continue; // Skip if the road is blocked
+                if (isRoadClosed(from, current) || overlay.isNodeClosed(from) || overlay.isNodeClosed(current)) {
+                    continue;
                 }
 
-                int tentativeGScore = gScore[current] + adjMatrix[current][neighbor];
-                if (tentativeGScore < gScore[neighbor]) {
-                    gScore[neighbor] = tentativeGScore;
-                    fScore[neighbor] = gScore[neighbor] + heuristic[neighbor];
-                    parent[neighbor] = current;
-                    openSet[neighbor] = 1; // Add neighbor to openSet
+                int tentative = facilityDist[current] + overlay.weigh(from * MAX_INTERSECTIONS + current, adjMatrix[from][current]);
+                if (tentative < facilityDist[from]) {
+                    facilityDist[from] = tentative;
+                    facilityNext[from] = current;
+                    nearestFacility[from] = nearestFacility[current];
                 }
             }
         }
+
+        facilityTreeValid = true;
+    }
+
+    // A closure only matters to the facility tree if the closed road is one of its edges
+    void invalidateFacilityTree(int idx1, int idx2) {
+        if (idx1 == -1 || idx2 == -1) {
+            return;
+        }
+        if (facilityNext[idx1] == idx2 || facilityNext[idx2] == idx1) {
+            facilityTreeValid = false;
+        }
     }
 
     // Check if a road is blocked
-    bool isRoadBlocked(const string& intersection1, const string& intersection2) {
-        for (int i = 0; i < roadClosureCount; ++i) {
-            if ((roadClosures[i].intersection1 == intersection1 && roadClosures[i].intersection2 == intersection2) ||
-                (roadClosures[i].intersection1 == intersection2 && roadClosures[i].intersection2 == intersection1)) {
-                if (roadClosures[i].status == "Blocked") {
-                    return true;
+    bool isRoadClosed(int idx1, int idx2) const {
+        return closedRoads.atomicTest(idx1 * MAX_INTERSECTIONS + idx2);
+    }
+
+    // Flip a road's closure bits (both directions); safe while searches are running
+    void setRoadClosed(int idx1, int idx2, bool closed) {
+        if (idx1 == -1 || idx2 == -1) {
+            return;
+        }
+        if (closed) {
+            closedRoads.atomicSet(idx1 * MAX_INTERSECTIONS + idx2);
+            closedRoads.atomicSet(idx2 * MAX_INTERSECTIONS + idx1);
+            connectivity.edgeRemoved(idx1 * MAX_INTERSECTIONS + idx2);
+            connectivity.edgeRemoved(idx2 * MAX_INTERSECTIONS + idx1);
+        } else {
+            closedRoads.atomicReset(idx1 * MAX_INTERSECTIONS + idx2);
+            closedRoads.atomicReset(idx2 * MAX_INTERSECTIONS + idx1);
+            if (adjMatrix[idx1][idx2] != INF) {
+                connectivity.edgeAdded(idx1 * MAX_INTERSECTIONS + idx2, idx1, idx2);
+            }
+        }
+    }
+
+    // False if no open roads join the two intersections
+    bool mayReach(int idx1, int idx2) {
+        if (connectivity.isStale()) {
+            connectivity.reset(intersectionCount);
+            for (int i = 0; i < intersectionCount; ++i) {
+                for (int j = 0; j < intersectionCount; ++j) {
+                    if (adjMatrix[i][j] != INF && !isRoadClosed(i, j)) {
+                        connectivity.edgeAdded(i * MAX_INTERSECTIONS + j, i, j);
+                    }
                 }
             }
         }
-        return false;
+        return connectivity.connected(idx1, idx2);
     }
 
 public:
     RoadNetwork() {
         intersectionCount = 0;
         roadClosureCount = 0;
+        facilityCount = 0;
+        facilityTreeValid = false;
         // Initialize adjacency matrix to INF
         for (int i = 0; i < MAX_INTERSECTIONS; ++i) {
+            heuristic[i] = 0;
             for (int j = 0; j < MAX_INTERSECTIONS; ++j) {
                 adjMatrix[i][j] = INF;
             }
         }
+        searchOffset[0] = 0;
     }
 
     void readRoadNetwork() {
@@ -1449,21 +6435,43 @@ public:
             getline(ss, intersection2, ',');
             ss >> time;
 
-            int idx1 = getIntersectionIndex(intersection1);
-            int idx2 = getIntersectionIndex(intersection2);
-
-            if (idx1 == -1) {
-                intersections[intersectionCount++] = intersection1;
-                idx1 = intersectionCount - 1;
-            }
-            if (idx2 == -1) {
-                intersections[intersectionCount++] = intersection2;
-                idx2 = intersectionCount - 1;
+            int idx1 = findOrAddIntersection(intersection1);
+            int idx2 = findOrAddIntersection(intersection2);
+            if (idx1 == -1 || idx2 == -1) {
+                continue;
             }
 
             adjMatrix[idx1][idx2] = time;
             adjMatrix[idx2][idx1] = time; // Assume undirected graph
         }
+
+        // Roads added or removed from the dashboard since the file was last rewritten
+        EditJournal::Reader reader("road_network.csv");
+        while (reader.next(line)) {
+            stringstream ss(line);
+            string op, intersection1, intersection2;
+            int time = 0;
+            getline(ss, op, ',');
+            getline(ss, intersection1, ',');
+            getline(ss, intersection2, ',');
+            ss >> time;
+
+            int idx1 = findOrAddIntersection(intersection1);
+            int idx2 = findOrAddIntersection(intersection2);
+            if (idx1 == -1 || idx2 == -1) {
+                continue;
+            }
+
+            if (op == "+") {
+                adjMatrix[idx1][idx2] = time;
+                adjMatrix[idx2][idx1] = time;
+            } else if (op == "-" && adjMatrix[idx1][idx2] == time) {
+                adjMatrix[idx1][idx2] = INF;
+                adjMatrix[idx2][idx1] = INF;
+            }
+        }
+        buildSearchGraph();
+        connectivity.markStale();
     }
 
     void readTrafficSignals() {
@@ -1477,6 +6485,9 @@ public:
             ss >> greenTimeVal;
 
             int idx = getIntersectionIndex(intersection);
+            if (idx == -1) {
+                continue; // Header line or unknown intersection
+            }
             heuristic[idx] = greenTimeVal; // Use greenTime as heuristic for simplicity
         }
     }
@@ -1484,62 +6495,109 @@ public:
     void readRoadClosures() {
         ifstream file("road_closures.csv");
         string line;
-        while (getline(file, line)) {
+        while (getline(file, line) && roadClosureCount < MAX_INTERSECTIONS * MAX_INTERSECTIONS) {
+            stringstream ss(line);
+            string intersection1, intersection2, status;
+            getline(ss, intersection1, ',');
+            getline(ss, intersection2, ',');
+            getline(ss, status);
+
+            addClosureRecord(intersection1, intersection2, status);
+
+            if (status == "Blocked") {
+                setRoadClosed(getIntersectionIndex(intersection1), getIntersectionIndex(intersection2), true);
+            }
+        }
+
+        // Closures made since the file was last rewritten
+        EditJournal::Reader reader("road_closures.csv");
+        while (reader.next(line)) {
             stringstream ss(line);
             string intersection1, intersection2, status;
             getline(ss, intersection1, ',');
             getline(ss, intersection2, ',');
             getline(ss, status);
 
-            roadClosures[roadClosureCount].intersection1 = intersection1;
-            roadClosures[roadClosureCount].intersection2 = intersection2;
-            roadClosures[roadClosureCount].status = status;
-            roadClosureCount++;
+            if (setClosureRecord(intersection1, intersection2, status) && status == "Blocked") {
+                setRoadClosed(getIntersectionIndex(intersection1), getIntersectionIndex(intersection2), true);
+            }
         }
+        closureJournal.open("road_closures.csv", reader);
     }
 
-void blockRoad() {
-    string roadStart, roadEnd;
-    cout << "Enter road to block (start, end): ";
-    cin >> roadStart >> roadEnd;
+    // Load hospitals / fire stations (Intersection,Type) from facilities.csv
+    void readFacilities() {
+        ifstream file("facilities.csv");
+        string line;
+        while (getline(file, line) && facilityCount < MAX_INTERSECTIONS) {
+            stringstream ss(line);
+            string intersection, type;
+            getline(ss, intersection, ',');
+            getline(ss, type);
 
-    bool roadFound = false;
+            int idx = getIntersectionIndex(intersection);
+            if (idx == -1) {
+                continue; // Header line or unknown intersection
+            }
 
-    // Mark this road as blocked
-    for (int i = 0; i < roadClosureCount; ++i) {
-        if ((roadClosures[i].intersection1 == roadStart && roadClosures[i].intersection2 == roadEnd) ||
-            (roadClosures[i].intersection1 == roadEnd && roadClosures[i].intersection2 == roadStart)) {
-            roadClosures[i].status = "Blocked";
-            roadFound = true;
-            cout << "Road " << roadStart << " to " << roadEnd << " is now blocked." << endl;
-            break;
+            facilities[facilityCount] = idx;
+            facilityTypes[facilityCount] = type;
+            facilityCount++;
         }
+        facilityTreeValid = false;
     }
 
-    // If the road doesn't exist yet in the closure list, add it
-    if (!roadFound) {
-        roadClosures[roadClosureCount].intersection1 = roadStart;
-        roadClosures[roadClosureCount].intersection2 = roadEnd;
-        roadClosures[roadClosureCount].status = "Blocked";
-        roadClosureCount++;
-        cout << "Road " << roadStart << " to " << roadEnd << " is now blocked." << endl;
-    }
+    // Copy the Graph's slowdowns and intersection closures so A* and the facility tree honour them too
+    // Only single-letter intersections exist in the Graph; other names are left untouched
+    void syncOverlay(const Graph& graph) {
+        WeightOverlay mirrored;
+        for (int i = 0; i < intersectionCount; ++i) {
+            if (intersections[i].size() != 1 || !graph.isIntersection(intersections[i][0])) {
+                continue;
+            }
+            char from = intersections[i][0];
+            if (graph.overlay.isNodeClosed(from - 'A')) {
+                mirrored.setNodeClosed(i, true);
+            }
+            for (int j = 0; j < intersectionCount; ++j) {
+                if (adjMatrix[i][j] == INF || intersections[j].size() != 1 || !graph.isIntersection(intersections[j][0])) {
+                    continue;
+                }
+                int id = graph.findEdgeId(from, intersections[j][0]);
+                if (id != -1) {
+                    mirrored.addSlowdown(i * MAX_INTERSECTIONS + j, graph.overlay.getExtraPercent(id));
+                }
+            }
+        }
 
-    // Update the CSV file
-    ofstream outFile("road_closures.csv");
-    if (!outFile.is_open()) {
-        cerr << "Error: Unable to open road_closures.csv for writing." << endl;
-        return;
+        overlay = mirrored;
+        facilityTreeValid = false;
     }
 
-    for (int i = 0; i < roadClosureCount; ++i) {
-        outFile << roadClosures[i].intersection1 << ","
-                << roadClosures[i].intersection2 << ","
-                << roadClosures[i].status << endl;
+// Reads the road from the user; returns false if it could not be blocked
+bool blockRoad(string &roadStart, string &roadEnd) {
+    cout << "Enter road to block (start, end): ";
+    cin >> roadStart >> roadEnd;
+
+    // Mark this road as blocked
+    if (!setClosureRecord(roadStart, roadEnd, "Blocked")) {
+        cerr << "Error: Too many road closures." << endl;
+        return false;
     }
+    cout << "Road " << roadStart << " to " << roadEnd << " is now blocked." << endl;
+
+    setRoadClosed(getIntersectionIndex(roadStart), getIntersectionIndex(roadEnd), true);
+    invalidateFacilityTree(getIntersectionIndex(roadStart), getIntersectionIndex(roadEnd));
 
-    outFile.close();
-    cout << "Road closures updated in road_closures.csv." << endl;
+    // Record the closure; road_closures.csv is only rewritten when the journal grows long
+    if (!closureJournal.append(roadStart + "," + roadEnd + ",Blocked")) {
+        return true;
+    }
+    if (closureJournal.needsCompaction()) {
+        closureJournal.compact(closuresCSV());
+    }
+    cout << "Road closures updated in road_closures.journal." << endl;
+    return true;
 }
 
 
@@ -1559,6 +6617,12 @@ void blockRoad() {
         int parent[MAX_INTERSECTIONS];
         cout << "Emergency Vehicle is being routed..." << endl;
 
+        // Cut off before A* explores everything it can reach
+        if (!mayReach(startIdx, endIdx)) {
+            cout << "No valid path available due to road closures!" << endl;
+            return;
+        }
+
         // Find the shortest path using A*
         aStar(startIdx, endIdx, parent);
 
@@ -1594,6 +6658,51 @@ void blockRoad() {
         cout << "Emergency Vehicle routed successfully." << endl;
     }
 
+    // Route an emergency vehicle to the closest facility by walking the precomputed tree
+    void routeToNearestFacility() {
+        string start;
+        cout << "Enter the intersection of the emergency: ";
+        cin >> start;
+
+        int current = getIntersectionIndex(start);
+        if (current == -1) {
+            cout << "Invalid intersection!" << endl;
+            return;
+        }
+
+        if (facilityCount == 0) {
+            cout << "No facilities loaded from facilities.csv!" << endl;
+            return;
+        }
+
+        if (!facilityTreeValid) {
+            buildFacilityTree();
+        }
+
+        int f = nearestFacility[current];
+        if (f == -1) {
+            cout << "No facility reachable due to road closures!" << endl;
+            return;
+        }
+
+        cout << "Nearest facility: " << facilityTypes[f] << " at " << intersections[facilities[f]]
+             << " (travel time " << facilityDist[current] << ")" << endl;
+
+        cout << "Emergency Vehicle path: ";
+        for (int at = current; at != -1; at = facilityNext[at]) {
+            cout << intersections[at];
+            if (facilityNext[at] != -1) cout << " -> ";
+        }
+        cout << endl;
+
+        cout << "Override Traffic Signals for Emergency Vehicle" << endl;
+        for (int at = current; at != -1; at = facilityNext[at]) {
+            cout << "Intersection " << intersections[at] << " overridden." << endl;
+        }
+
+        cout << "Emergency Vehicle routed successfully." << endl;
+    }
+
     void displayBlockedRoads() {
         cout << "Blocked Roads:" << endl;
         for (int i = 0; i < roadClosureCount; ++i) {
@@ -1608,6 +6717,9 @@ private:
     // Constants inside the class
     static const int MAX_INTERSECTIO = 26;
     static const int MAX_ROADS = 2;
+    // Travel times are kept in 16 bits for the route search, and no path of them may reach SEARCH_UNREACHABLE
+    static const int MAX_TRAVEL_TIME = (SEARCH_UNREACHABLE - 1) / MAX_INTERSECTIONS;
+    static_assert(MAX_TRAVEL_TIME <= UINT16_MAX, "travel times must fit the 16-bit search weights");
 
     // Structure definitions for Road and Junction within the class
     struct Road {
@@ -1633,6 +6745,13 @@ private:
         return -1;
     }
 
+    // Keep a travel time within what the route search can hold
+    static int clampTravelTime(long long travelTime) {
+        if (travelTime < 1) return 1;
+        if (travelTime > MAX_TRAVEL_TIME) return MAX_TRAVEL_TIME;
+        return (int)travelTime;
+    }
+
     int getRoadIndex(int fromIdx, const string& to) {
         for (int i = 0; i < junctions[fromIdx].roadCount; ++i) {
             if (junctions[fromIdx].roads[i].destination == to) return i;
@@ -1640,18 +6759,6 @@ private:
         return -1;
     }
 
-    // Helper function to calculate minimum distance (used for dynamic programming)
-    int minDistance(int dist[], bool sptSet[]) {
-        int min = INT_MAX, min_index;
-        for (int v = 0; v < junctionCount; v++) {
-            if (!sptSet[v] && dist[v] <= min) {
-                min = dist[v];
-                min_index = v;
-            }
-        }
-        return min_index;
-    }
-
     void dynamicProgrammingRoute(const string& start, const string& end) {
         int startIdx = getJunctionIndex(start);
         int endIdx = getJunctionIndex(end);
@@ -1661,29 +6768,36 @@ private:
             return;
         }
 
-        int dist[MAX_INTERSECTIONS];
-        bool sptSet[MAX_INTERSECTIONS];
-        int parent[MAX_INTERSECTIONS]; // For route reconstruction
-
-        for (int i = 0; i < junctionCount; i++) {
-            dist[i] = INT_MAX;
-            sptSet[i] = false;
+        // moveVehicle() keeps travel times within [1, MAX_TRAVEL_TIME], so the roads are searched
+        // with 16-bit weights and a radix queue
+        int offset[MAX_INTERSECTIONS + 1];
+        int target[MAX_INTERSECTIONS * MAX_ROADS];
+        int roadId[MAX_INTERSECTIONS * MAX_ROADS];
+        uint16_t weight[MAX_INTERSECTIONS * MAX_ROADS];
+        int position = 0;
+        for (int u = 0; u < junctionCount; u++) {
+            offset[u] = position;
+            for (int r = 0; r < junctions[u].roadCount; r++) {
+                target[position] = getJunctionIndex(junctions[u].roads[r].destination);
+                roadId[position] = u * MAX_ROADS + r;
+                int travelTime = junctions[u].roads[r].baseTravelTime;
+                assert(travelTime >= 1 && travelTime <= MAX_TRAVEL_TIME);
+                weight[position] = (uint16_t)travelTime;
+                position++;
+            }
         }
+        offset[junctionCount] = position;
 
-        dist[startIdx] = 0;
-        parent[startIdx] = -1;
+        int sources[1] = {startIdx};
 
-        for (int count = 0; count < junctionCount - 1; count++) {
-            int u = minDistance(dist, sptSet);
-            sptSet[u] = true;
+        SearchGraph<uint16_t> view = {junctionCount, offset, target, roadId, weight};
+        Router<uint16_t, RadixQueue, NoFilter, ZeroHeuristic> router(view, NoFilter(), ZeroHeuristic());
+        int distance = router.search(sources, 1, endIdx);
+        const SearchWorkspace<RadixQueue> &workspace = router.getWorkspace();
 
-            for (int v = 0; v < junctionCount; v++) {
-                int roadIdx = getRoadIndex(u, junctions[v].name);
-                if (!sptSet[v] && roadIdx != -1 && dist[u] != INT_MAX && dist[u] + junctions[u].roads[roadIdx].baseTravelTime < dist[v]) {
-                    dist[v] = dist[u] + junctions[u].roads[roadIdx].baseTravelTime;
-                    parent[v] = u;
-                }
-            }
+        if (distance == SEARCH_UNREACHABLE) {
+            cout << "No route found from " << start << " to " << end << endl;
+            return;
         }
 
         // Display the shortest path
@@ -1691,10 +6805,10 @@ private:
         int current = endIdx;
         while (current != -1) {
             cout << junctions[current].name << " ";
-            current = parent[current];
+            current = workspace.getParent(current);
         }
         cout << endl;
-        cout << "Total travel time: " << dist[endIdx] << " minutes" << endl;
+        cout << "Total travel time: " << distance << " minutes" << endl;
     }
 
 public:
@@ -1785,13 +6899,12 @@ public:
              << " | Base Travel Time: " << junctions[fromIdx].roads[fromRoadIdx].baseTravelTime << endl;
 
         junctions[fromIdx].roads[fromRoadIdx].vehicleCount -= vehicleCount;
-        int newTravelTime = junctions[fromIdx].roads[fromRoadIdx].baseTravelTime - (vehicleCount / 10) - timeAdjustment;
-        if (newTravelTime < 1) newTravelTime = 1;
-        junctions[fromIdx].roads[fromRoadIdx].baseTravelTime = newTravelTime;
+        long long newTravelTime = (long long)junctions[fromIdx].roads[fromRoadIdx].baseTravelTime - (vehicleCount / 10) - timeAdjustment;
+        junctions[fromIdx].roads[fromRoadIdx].baseTravelTime = clampTravelTime(newTravelTime);
 
         junctions[toIdx].roads[toRoadIdx].vehicleCount += vehicleCount;
-        newTravelTime = junctions[toIdx].roads[toRoadIdx].baseTravelTime + (vehicleCount / 10) + timeAdjustment;
-        junctions[toIdx].roads[toRoadIdx].baseTravelTime = newTravelTime;
+        newTravelTime = (long long)junctions[toIdx].roads[toRoadIdx].baseTravelTime + (vehicleCount / 10) + timeAdjustment;
+        junctions[toIdx].roads[toRoadIdx].baseTravelTime = clampTravelTime(newTravelTime);
 
         cout << "After moving: \n";
         displayState();
@@ -1811,7 +6924,11 @@ int main()
     // Initialize the graph for the city's road network
     Graph graph(100);  // Assume 100 intersections for this example
     graph.loadFromCSV("road_network.csv");  // Load the road network from a CSV file
-    graph.loadBlockedRoads("road_closures.csv");  // Load blocked roads (closures)
+    graph.watchBlockedRoads("road_closures.csv");  // Load blocked roads (closures) and reload them when the file changes
+
+    // Planned roadworks and accidents, applied as the simulation clock advances
+    ClosureSchedule schedule;
+    schedule.loadFromCSV(graph, "scheduled_closures.csv");
 
     // Initialize the traffic simulator
     TrafficSimulator simulator;
@@ -1826,10 +6943,17 @@ int main()
 
     RoadNetwork network;
 
+    // Fast route engines, prepared lazily on first use
+    OverlayRouter overlay;
+    HubLabels *hubLabels = new HubLabels();
+    ArcFlags arcFlags;
+    CriticalRoads criticalRoads;
+
     // Read data from CSV files
     network.readRoadNetwork();
     network.readTrafficSignals();
     network.readRoadClosures();
+    network.readFacilities();
 
 
     int choice;
@@ -1848,6 +6972,11 @@ int main()
         cout << "10. Check blocked roads\n";
         cout << "11. Route emergency vehicle\n";
         cout<<"12. Smart route\n";
+        cout << "13. Route emergency vehicle to nearest facility\n";
+        cout << "14. Service area (isochrone)\n";
+        cout << "15. Fast route (overlay / hub labels / arc flags)\n";
+        cout << "16. Advance simulation clock\n";
+        cout << "17. Critical roads (bridges and articulation intersections)\n";
         cout << "0. Exit\n";
         cout << "Enter your choice: ";
         cin >> choice;
@@ -1863,6 +6992,7 @@ int main()
             if (manageChoice == 'y' || manageChoice == 'Y') 
             {
                 graph.manageRoads();  // Manage roads and intersections (add/remove roads)
+                network.syncOverlay(graph);  // Emergency routing sees the same slowdowns and closed intersections
             }
             else if (manageChoice != 'y' && manageChoice != 'Y' && manageChoice != 'n' && manageChoice != 'N') 
             {
@@ -1878,7 +7008,7 @@ int main()
             cin >> start;
             cout << "Enter ending intersection: ";
             cin >> end;
-            graph.loadBlockedRoads("road_closures.csv");
+            graph.refreshBlockedRoads();
 
             graph.dijkstra(start, end, false);  // Use Dijkstra's algorithm to find the shortest path
         }
@@ -1896,7 +7026,7 @@ int main()
         }
         else if (choice == 4) 
         {
-            graph.loadBlockedRoads("road_closures.csv");
+            graph.refreshBlockedRoads();
 
             // Display vehicle information
             simulator.displayVehiclesInfo(graph);
@@ -1924,8 +7054,23 @@ int main()
         {
             traffic.showCongestion();
 
+            // Sketch mode keeps no per-vehicle records, so trips are looked up by vehicle ID
+            if (traffic.sketching())
+            {
+                string vehicleID;
+                cout << "Enter a vehicle ID to estimate its trips (- to skip): ";
+                cin >> vehicleID;
+                if (vehicleID != "-")
+                {
+                    char start, end;
+                    cout << "Enter the road (start and end intersections): ";
+                    cin >> start >> end;
+                    traffic.showVehicleTrips(vehicleID, start, end);
+                }
+            }
+
             int rerouteChoice;
-            cout << "Do you want to reroute traffic using BFS or DFS?" << endl << "1 for BFS" << endl << "2 for DFS. ";
+            cout << "Do you want to reroute traffic using BFS or DFS?" << endl << "1 for BFS" << endl << "2 for DFS" << endl << "3 for alternative routes. ";
             cin >> rerouteChoice;
 
             if (rerouteChoice == 1)
@@ -1948,6 +7093,17 @@ int main()
                     }
                 }
             }
+            else if (rerouteChoice == 3)
+            {
+                char start, end;
+                cout << "Enter starting intersection: ";
+                cin >> start;
+                cout << "Enter ending intersection: ";
+                cin >> end;
+                graph.refreshBlockedRoads();
+
+                graph.showAlternativeRoutes(start, end, 3);
+            }
             else
             {
                 cout << "Invalid choice. Try again.\n";
@@ -1955,7 +7111,16 @@ int main()
         }
         else if(choice==9)
         {
-            network.blockRoad();
+            string roadStart, roadEnd;
+            if (network.blockRoad(roadStart, roadEnd))
+            {
+                // Warn while the road is still open whether the closure splits the network
+                criticalRoads.reportClosure(graph, roadStart[0], roadEnd[0]);
+            }
+
+            // Pick the closure up from the journal and reroute only the vehicles that used the road
+            graph.refreshBlockedRoads();
+            simulator.rerouteClosedRoads(graph);
         }
         else if(choice==10){
             network.displayBlockedRoads();
@@ -1971,6 +7136,48 @@ int main()
     calculator.moveVehicle();
     calculator.findBestRoute();
         }
+        else if(choice==13){
+            network.routeToNearestFacility();
+        }
+        else if (choice == 14)
+        {
+            graph.refreshBlockedRoads();
+            graph.serviceArea();
+        }
+        else if (choice == 15)
+        {
+            char start, end;
+
+            cout << "Enter starting intersection: ";
+            cin >> start;
+            cout << "Enter ending intersection: ";
+            cin >> end;
+            graph.refreshBlockedRoads();
+
+            int engine;
+            cout << "Choose engine (1 for overlay, 2 for hub labels, 3 for arc flags): ";
+            cin >> engine;
+
+            if (engine == 1)
+                overlay.route(graph, start, end);
+            else if (engine == 2)
+                hubLabels->query(graph, start, end, false);
+            else if (engine == 3)
+                arcFlags.query(graph, start, end, false);
+            else
+                cout << "Invalid choice. Try again.\n";
+        }
+        else if (choice == 16)
+        {
+            schedule.advance(graph);
+            traffic.advanceTo(schedule.getTime());
+            simulator.rerouteClosedRoads(graph);
+        }
+        else if (choice == 17)
+        {
+            graph.refreshBlockedRoads();
+            criticalRoads.display(graph);
+        }
         else if (choice != 0) 
         {
             cout << "Invalid choice. Try again.\n";
@@ -1978,5 +7185,6 @@ int main()
 
     } while (choice != 0);
 
+    delete hubLabels;
     return 0;
 }